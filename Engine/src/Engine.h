@@ -5,6 +5,7 @@
 #include "Engine/Core/Camera.h"
 #include "Engine/Core/Core.h"
 #include "Engine/Core/Input.h"
+#include "Engine/Core/JobSystem.h"
 #include "Engine/Core/KeyCodes.h"
 #include "Engine/Core/Layer.h"
 #include "Engine/Core/LayerStack.h"
@@ -25,9 +26,13 @@
 /* All ECS related */
 #include "Engine/ECS/Components.h"
 #include "Engine/ECS/ComponentsManager.h"
+#include "Engine/ECS/EntityCommandBuffer.h"
 #include "Engine/ECS/EntityId.h"
 #include "Engine/ECS/EntityManager.h"
+#include "Engine/ECS/Group.h"
 #include "Engine/ECS/Registry.h"
+#include "Engine/ECS/RegistrySnapshot.h"
+#include "Engine/ECS/SystemGraph.h"
 #include "Engine/ECS/View.h"
 
 /* Events */
@@ -10,7 +10,7 @@ namespace Engine
     static_assert(Math::IsPowerOf2(SPARSE_SET_PAGE_SIZE), "Page size must be a power of 2");
     static const U32 SPARSE_SET_PAGE_SIZE_LOG = Math::Log2(SPARSE_SET_PAGE_SIZE);
     
-    // ST - sparse type, DT - dense type, Dec - dense type decomposer.
+    // ST - sparse type, DT - dense type, Dec - dense type decomposer (its `NULL_FLAG` is the default null flag).
     template <typename ST, typename DT, typename Dec>
     class SparseSetPaged
     {
@@ -35,20 +35,36 @@ namespace Engine
             std::vector<DT>& m_Dense;
         };
     public:
-        SparseSetPaged(ST nullFlag = static_cast<ST>(NULL_ENTITY));
+        SparseSetPaged(ST nullFlag = static_cast<ST>(Dec::NULL_FLAG));
         ST Push(DT value);
         template <typename PushCallback>
         ST Push(DT value, PushCallback callback = [](ST value){});
         void Pop(DT value);
         template <typename PopCallback, typename SwapCallback>
         void Pop(DT value, PopCallback popCallback = [](ST value){}, SwapCallback swapCallback = [](ST a, ST b) {});
+        // Removes values at (sorted, unique) dense `indices` in a single compaction pass,
+        // order of the remaining values is preserved.
+        // `moveCallback(from, to)` is called for every value that changes its dense index.
+        template <typename PopCallback, typename MoveCallback>
+        void PopBatch(const std::vector<ST>& indices, PopCallback popCallback, MoveCallback moveCallback);
+        // Removes value, but keeps its dense slot (filled with `tombstone`), so that other values are not moved.
+        // Returns the freed dense index.
+        ST PopInPlace(DT value, DT tombstone);
+        // Puts value into dense slot `index`, that was freed by `PopInPlace`.
+        ST PushAt(DT value, ST index);
+        // Appends `tombstone` to dense array (as if value was pushed and then popped in place).
+        ST PushTombstone(DT tombstone);
+        // Swaps values at dense indices `a` and `b` (keeping sparse part consistent).
+        void Swap(ST a, ST b);
         // Checks if value, that was generated by this set, still belongs to it. 
         bool Has(DT value) const;
 
         ST GetIndexOf(DT value) const;
+        // Same as `GetIndexOf`, but returns null flag if value does not belong to set (single sparse probe).
+        ST TryGetIndexOf(DT value) const;
         
         DT& operator[](DT value);
-        const DT& operator[](DT value) const;
+        DT operator[](DT value) const;
         
         Iterator begin() { return Iterator(m_Dense, static_cast<U32>(m_Dense.size() - 1)); }
         Iterator end() { return Iterator(m_Dense, -1); }
@@ -56,6 +72,12 @@ namespace Engine
         ST GetNullFlag() const { return m_NullFlag; }
 
         const std::vector<DT>& GetDense() const { return m_Dense; }
+        // Reserves dense capacity for `capacity` values.
+        void Reserve(U32 capacity) { m_Dense.reserve(capacity); }
+        // Removes all values, sparse pages stay allocated.
+        void Clear();
+        // Releases sparse pages, that are not referenced by any value, and unused dense capacity.
+        void ShrinkToFit();
         
     private:
         std::vector<ST>* GetOrCreate(U32 index);
@@ -158,6 +180,113 @@ namespace Engine
         m_Dense.pop_back();
     }
 
+    template <typename ST, typename DT, typename Dec>
+    template <typename PopCallback, typename MoveCallback>
+    void SparseSetPaged<ST, DT, Dec>::PopBatch(const std::vector<ST>& indices, PopCallback popCallback, MoveCallback moveCallback)
+    {
+        if (indices.empty()) return;
+        ST write = indices.front();
+        U32 nextToPop = 0;
+        for (ST read = indices.front(); read < static_cast<ST>(m_Dense.size()); read++)
+        {
+            auto&& [gen, index] = Dec::Decompose(m_Dense[read]);
+            auto* sparseSet = TryGet(index);
+            auto mappedIndex = Math::FastMod(index, SPARSE_SET_PAGE_SIZE);
+            if (nextToPop < indices.size() && indices[nextToPop] == read)
+            {
+                popCallback(read);
+                // Tombstones (see `PopInPlace`) have no sparse entry.
+                if (sparseSet) (*sparseSet)[mappedIndex] = m_NullFlag;
+                nextToPop++;
+                continue;
+            }
+            moveCallback(read, write);
+            (*sparseSet)[mappedIndex] = write;
+            m_Dense[write] = m_Dense[read];
+            write++;
+        }
+        ENGINE_CORE_ASSERT(nextToPop == indices.size(), "Invalid indices.")
+        m_Dense.resize(write);
+    }
+
+    template <typename ST, typename DT, typename Dec>
+    ST SparseSetPaged<ST, DT, Dec>::PopInPlace(DT value, DT tombstone)
+    {
+        auto&& [gen, index] = Dec::Decompose(value);
+        auto* sparseSet = TryGet(index);
+        auto mappedIndex = Math::FastMod(index, SPARSE_SET_PAGE_SIZE);
+        ENGINE_CORE_ASSERT(sparseSet, "Invalid value.")
+        ENGINE_CORE_ASSERT((*sparseSet)[mappedIndex] != m_NullFlag, "No such value.")
+        ST denseIndex = (*sparseSet)[mappedIndex];
+        m_Dense[denseIndex] = tombstone;
+        (*sparseSet)[mappedIndex] = m_NullFlag;
+        return denseIndex;
+    }
+
+    template <typename ST, typename DT, typename Dec>
+    ST SparseSetPaged<ST, DT, Dec>::PushAt(DT value, ST index)
+    {
+        auto&& [gen, valueIndex] = Dec::Decompose(value);
+        auto* sparseSet = GetOrCreate(valueIndex);
+        auto mappedIndex = Math::FastMod(valueIndex, SPARSE_SET_PAGE_SIZE);
+        ENGINE_CORE_ASSERT(index < static_cast<ST>(m_Dense.size()), "Invalid index.")
+        ENGINE_CORE_ASSERT((*sparseSet)[mappedIndex] == m_NullFlag, "Value is already set.")
+        (*sparseSet)[mappedIndex] = index;
+        m_Dense[index] = value;
+        return index;
+    }
+
+    template <typename ST, typename DT, typename Dec>
+    ST SparseSetPaged<ST, DT, Dec>::PushTombstone(DT tombstone)
+    {
+        m_Dense.push_back(tombstone);
+        return static_cast<ST>(m_Dense.size() - 1);
+    }
+
+    template <typename ST, typename DT, typename Dec>
+    void SparseSetPaged<ST, DT, Dec>::Swap(ST a, ST b)
+    {
+        ENGINE_CORE_ASSERT(a < static_cast<ST>(m_Dense.size()) && b < static_cast<ST>(m_Dense.size()), "Invalid index.")
+        if (a == b) return;
+        auto&& [aGen, aIndex] = Dec::Decompose(m_Dense[a]);
+        auto&& [bGen, bIndex] = Dec::Decompose(m_Dense[b]);
+        auto* aSparseSet = TryGet(aIndex);
+        auto* bSparseSet = TryGet(bIndex);
+        std::swap((*aSparseSet)[Math::FastMod(aIndex, SPARSE_SET_PAGE_SIZE)], (*bSparseSet)[Math::FastMod(bIndex, SPARSE_SET_PAGE_SIZE)]);
+        std::swap(m_Dense[a], m_Dense[b]);
+    }
+
+    template <typename ST, typename DT, typename Dec>
+    void SparseSetPaged<ST, DT, Dec>::Clear()
+    {
+        for (auto value : m_Dense)
+        {
+            auto&& [gen, index] = Dec::Decompose(value);
+            if (auto* sparseSet = TryGet(index)) (*sparseSet)[Math::FastMod(index, SPARSE_SET_PAGE_SIZE)] = m_NullFlag;
+        }
+        m_Dense.clear();
+    }
+
+    template <typename ST, typename DT, typename Dec>
+    void SparseSetPaged<ST, DT, Dec>::ShrinkToFit()
+    {
+        std::vector<bool> isPageUsed(m_SparsePaged.size(), false);
+        for (auto value : m_Dense)
+        {
+            auto&& [gen, index] = Dec::Decompose(value);
+            // Tombstones point past the last page.
+            U32 pageNum = index >> SPARSE_SET_PAGE_SIZE_LOG;
+            if (pageNum < isPageUsed.size()) isPageUsed[pageNum] = true;
+        }
+        for (U32 pageNum = 0; pageNum < m_SparsePaged.size(); pageNum++)
+        {
+            if (!isPageUsed[pageNum]) m_SparsePaged[pageNum].reset();
+        }
+        while (!m_SparsePaged.empty() && !m_SparsePaged.back()) m_SparsePaged.pop_back();
+        m_SparsePaged.shrink_to_fit();
+        m_Dense.shrink_to_fit();
+    }
+
     template <typename ST, typename DT, typename Dec>
     bool SparseSetPaged<ST, DT, Dec>::Has(DT value) const
     {
@@ -179,6 +308,18 @@ namespace Engine
         return (*sparseSet)[mappedIndex];
     }
 
+    template <typename ST, typename DT, typename Dec>
+    ST SparseSetPaged<ST, DT, Dec>::TryGetIndexOf(DT value) const
+    {
+        auto&& [gen, index] = Dec::Decompose(value);
+        auto* sparseSet = TryGet(index);
+        if (sparseSet == nullptr) return m_NullFlag;
+        auto mappedIndex = Math::FastMod(index, SPARSE_SET_PAGE_SIZE);
+        ST sparseI = (*sparseSet)[mappedIndex];
+        if (sparseI < static_cast<ST>(m_Dense.size()) && m_Dense[sparseI] == value) return sparseI;
+        return m_NullFlag;
+    }
+
     template <typename ST, typename DT, typename Dec>
     DT& SparseSetPaged<ST, DT, Dec>::operator[](DT value)
     {
@@ -190,7 +331,7 @@ namespace Engine
     }
 
     template <typename ST, typename DT, typename Dec>
-    const DT& SparseSetPaged<ST, DT, Dec>::operator[](DT value) const
+    DT SparseSetPaged<ST, DT, Dec>::operator[](DT value) const
     {
         auto&& [gen, index] = Dec::Decompose(value);
         auto* sparseSet = TryGet(index);
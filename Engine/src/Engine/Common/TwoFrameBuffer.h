@@ -11,6 +11,11 @@ namespace Engine
     class TwoFrameBuffer
     {
     public:
+        TwoFrameBuffer() = default;
+        // Both buffers are constructed from `args` (e.g. memory resource).
+        template <typename ... Args>
+        explicit TwoFrameBuffer(const Args&... args) : m_Buffers{Container(args...), Container(args...)} {}
+
         const Container& GetReadBuffer() const { return m_Buffers[m_ReadBufferIndex]; }
         Container& GetReadBuffer() { return m_Buffers[m_ReadBufferIndex]; }
         const Container& GetWriteBuffer() const { return m_Buffers[m_ReadBufferIndex ^ 1]; }
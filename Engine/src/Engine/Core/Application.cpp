@@ -4,6 +4,7 @@
 #include <ranges>
 
 #include "Engine/Core/Input.h"
+#include "Engine/Memory/FrameAllocator.h"
 #include "Engine/Memory/MemoryManager.h"
 #include "Engine/Rendering/Renderer.h"
 
@@ -43,7 +44,8 @@ namespace Engine {
 
 	void Application::OnUpdate()
 	{
-	
+		// Reclaims transient memory of the frame `FRAME_ALLOCATOR_FRAMES` frames ago.
+		FrameAllocator::BeginFrame();
 		m_Window->OnUpdate();
 
 		m_ImguiLayer->BeginFrame();
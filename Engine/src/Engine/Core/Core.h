@@ -3,8 +3,14 @@
 #include "Log.h"
 #include "Engine/Core/Types.h"
 
-#define ENGINE_ASSERT(x, ...) if (x) {} else { ENGINE_ERROR("Assertion failed: {}", __VA_ARGS__); __debugbreak(); }
-#define ENGINE_CORE_ASSERT(x, ...) if (x) {} else { ENGINE_CORE_ERROR("Assertion failed: {}", __VA_ARGS__); __debugbreak(); }
+#ifdef _MSC_VER
+	#define ENGINE_DEBUGBREAK() __debugbreak()
+#else
+	#define ENGINE_DEBUGBREAK() __builtin_trap()
+#endif
+
+#define ENGINE_ASSERT(x, ...) if (x) {} else { ENGINE_ERROR("Assertion failed: {}", __VA_ARGS__); ENGINE_DEBUGBREAK(); }
+#define ENGINE_CORE_ASSERT(x, ...) if (x) {} else { ENGINE_CORE_ERROR("Assertion failed: {}", __VA_ARGS__); ENGINE_DEBUGBREAK(); }
 
 #define ENGINE_CHECK_RETURN(x, ...) if (x) {} else { ENGINE_ERROR("{}", __VA_ARGS__); return; }
 #define ENGINE_CORE_CHECK_RETURN(x, ...) if (x) {} else { ENGINE_CORE_ERROR("{}", __VA_ARGS__); return; }
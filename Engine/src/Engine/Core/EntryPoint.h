@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Application.h"
+#include "JobSystem.h"
 #include "Log.h"
+#include "Engine/Memory/FrameAllocator.h"
 #include "Engine/Memory/MemoryManager.h"
 #include "Engine/Rendering/Renderer.h"
 #include "Engine/Resource/ResourceManager.h"
@@ -13,6 +15,8 @@ int main(int argc, char** argv)
 {
 	Engine::Log::Init();
 	Engine::MemoryManager::Init();
+	Engine::FrameAllocator::Init();
+	Engine::JobSystem::Init();
 	// Scope, so app gets destroyed before MemoryManager.
 	{
 		auto app = Engine::createApplication();
@@ -21,5 +25,7 @@ int main(int argc, char** argv)
 	Engine::Renderer::ShutDown();
 	Engine::ResourceManager::ShutDown();
 	Engine::Physics::DefaultContactListener::Shutdown();
+	Engine::JobSystem::ShutDown();
+	Engine::FrameAllocator::ShutDown();
 	Engine::MemoryManager::ShutDown();
 }
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "enginepch.h"
+
+#include "JobSystem.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Memory/MemoryManager.h"
+
+namespace Engine
+{
+	std::vector<std::thread> JobSystem::s_Workers;
+	std::vector<Ref<JobSystem::WorkStealingQueue>> JobSystem::s_Queues;
+	std::atomic<U32> JobSystem::s_PendingJobs{0};
+	std::atomic<bool> JobSystem::s_IsRunning{false};
+	std::mutex JobSystem::s_WakeMutex;
+	std::condition_variable JobSystem::s_WakeCondition;
+
+	void JobSystem::WorkStealingQueue::Push(Job&& job)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Jobs.push_back(std::move(job));
+	}
+
+	bool JobSystem::WorkStealingQueue::Pop(Job& job)
+	{
+		std::lock_guard lock(m_Mutex);
+		if (m_Jobs.empty()) return false;
+		job = std::move(m_Jobs.back());
+		m_Jobs.pop_back();
+		return true;
+	}
+
+	bool JobSystem::WorkStealingQueue::Steal(Job& job)
+	{
+		std::lock_guard lock(m_Mutex);
+		if (m_Jobs.empty()) return false;
+		job = std::move(m_Jobs.front());
+		m_Jobs.pop_front();
+		return true;
+	}
+
+	void JobSystem::Init(U32 workerCount)
+	{
+		if (workerCount == 0)
+		{
+			U32 hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+		s_IsRunning = true;
+		s_ThreadIndex = 0;
+		// Queue of main thread is the first one.
+		for (U32 i = 0; i < workerCount + 1; i++)
+		{
+			s_Queues.push_back(CreateRef<WorkStealingQueue>());
+		}
+		for (U32 i = 0; i < workerCount; i++)
+		{
+			s_Workers.emplace_back(WorkerLoop, i + 1);
+		}
+		ENGINE_CORE_INFO("Job system: {} worker threads", workerCount);
+	}
+
+	void JobSystem::ShutDown()
+	{
+		{
+			std::lock_guard lock(s_WakeMutex);
+			s_IsRunning = false;
+		}
+		s_WakeCondition.notify_all();
+		for (auto& worker : s_Workers)
+		{
+			worker.join();
+		}
+		s_Workers.clear();
+		s_Queues.clear();
+	}
+
+	void JobSystem::Submit(JobFn job, JobCounter* counter)
+	{
+		ENGINE_CORE_ASSERT(!s_Queues.empty(), "Job system is not initialized")
+		if (counter) counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+		{
+			// Lock prevents the wake up from being lost between worker's check and wait.
+			std::lock_guard lock(s_WakeMutex);
+			s_PendingJobs.fetch_add(1, std::memory_order_release);
+		}
+		s_Queues[s_ThreadIndex]->Push({std::move(job), counter});
+		s_WakeCondition.notify_one();
+	}
+
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!TryExecuteJob()) std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::WorkerLoop(U32 threadIndex)
+	{
+		s_ThreadIndex = threadIndex;
+		while (true)
+		{
+			if (TryExecuteJob()) continue;
+			std::unique_lock lock(s_WakeMutex);
+			s_WakeCondition.wait(lock, []() { return !s_IsRunning || s_PendingJobs.load(std::memory_order_acquire) > 0; });
+			if (!s_IsRunning) break;
+		}
+	}
+
+	bool JobSystem::TryExecuteJob()
+	{
+		Job job;
+		// Own jobs first (lifo, better cache usage), then steal from others (fifo).
+		bool hasJob = s_Queues[s_ThreadIndex]->Pop(job);
+		for (U32 i = 1; !hasJob && i < s_Queues.size(); i++)
+		{
+			hasJob = s_Queues[(s_ThreadIndex + i) % s_Queues.size()]->Steal(job);
+		}
+		if (!hasJob) return false;
+		s_PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+		Execute(job);
+		return true;
+	}
+
+	void JobSystem::Execute(Job& job)
+	{
+		job.Fn();
+		if (job.Counter) job.Counter->m_Count.fetch_sub(1, std::memory_order_acq_rel);
+	}
+}
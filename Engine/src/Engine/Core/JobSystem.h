@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Engine/Core/Core.h"
+#include "Engine/Core/Types.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Engine
+{
+	using namespace Types;
+
+	// Counts unfinished jobs, used as a fence to wait for a group of jobs.
+	class JobCounter
+	{
+		friend class JobSystem;
+	public:
+		bool IsDone() const { return m_Count.load(std::memory_order_acquire) == 0; }
+	private:
+		std::atomic<U32> m_Count{0};
+	};
+
+	class JobSystem
+	{
+	public:
+		using JobFn = std::function<void()>;
+	private:
+		struct Job
+		{
+			JobFn Fn;
+			JobCounter* Counter{nullptr};
+		};
+
+		// Owner pushes and pops from the back, thieves steal from the front.
+		class WorkStealingQueue
+		{
+		public:
+			void Push(Job&& job);
+			bool Pop(Job& job);
+			bool Steal(Job& job);
+		private:
+			std::deque<Job> m_Jobs;
+			std::mutex m_Mutex;
+		};
+	public:
+		// Shall be called in entry point, `workerCount` of 0 means "hardware threads - 1".
+		static void Init(U32 workerCount = 0);
+
+		// Shall be called in entry point (joins worker threads).
+		static void ShutDown();
+
+		// Schedules a job, `counter` (if any) is incremented now and decremented when job is finished.
+		static void Submit(JobFn job, JobCounter* counter = nullptr);
+
+		// Waits for all jobs of the counter, calling thread executes pending jobs meanwhile.
+		static void Wait(const JobCounter& counter);
+
+		// Splits [0, count) into ranges of `grainSize` and calls `fn(begin, end)` for each of them
+		// on worker threads. Returns when all ranges are processed.
+		template <typename Fn>
+		static void ParallelFor(U32 count, U32 grainSize, Fn fn);
+
+		// Number of threads jobs can run on (workers + main thread).
+		static U32 GetThreadCount() { return static_cast<U32>(s_Queues.size()); }
+		// Index of the calling thread (0 for main thread).
+		static U32 GetThreadIndex() { return s_ThreadIndex; }
+	private:
+		static void WorkerLoop(U32 threadIndex);
+		static bool TryExecuteJob();
+		static void Execute(Job& job);
+	private:
+		static std::vector<std::thread> s_Workers;
+		static std::vector<Ref<WorkStealingQueue>> s_Queues;
+
+		static std::atomic<U32> s_PendingJobs;
+		static std::atomic<bool> s_IsRunning;
+		static std::mutex s_WakeMutex;
+		static std::condition_variable s_WakeCondition;
+
+		inline static thread_local U32 s_ThreadIndex = 0;
+	};
+
+	template <typename Fn>
+	void JobSystem::ParallelFor(U32 count, U32 grainSize, Fn fn)
+	{
+		if (count == 0) return;
+		grainSize = std::max(grainSize, 1u);
+		// Not worth scheduling.
+		if (count <= grainSize || GetThreadCount() <= 1)
+		{
+			fn(0u, count);
+			return;
+		}
+		JobCounter counter;
+		for (U32 begin = grainSize; begin < count; begin += grainSize)
+		{
+			U32 end = std::min(count, begin + grainSize);
+			Submit([&fn, begin, end]() { fn(begin, end); }, &counter);
+		}
+		// The first range is processed by the calling thread.
+		fn(0u, grainSize);
+		Wait(counter);
+	}
+}
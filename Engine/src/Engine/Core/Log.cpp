@@ -1,9 +1,13 @@
 #include "enginepch.h"
 #include "Log.h"
 
+#ifdef _MSC_VER
 #pragma warning (push, 0)
+#endif
 #include <spdlog/sinks/stdout_color_sinks.h>
+#ifdef _MSC_VER
 #pragma warning (pop)
+#endif
 
 constexpr auto CORE_LOGGER_NAME = "CoreLogger";
 constexpr auto CLIENT_LOGGER_NAME = "ClientLogger";
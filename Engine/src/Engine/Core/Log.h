@@ -2,9 +2,13 @@
 
 #include <memory>
 
+#ifdef _MSC_VER
 #pragma warning (push, 0)
+#endif
 #include <spdlog/spdlog.h>
+#ifdef _MSC_VER
 #pragma warning (pop)
+#endif
 
 namespace Engine {
 	
@@ -19,10 +19,10 @@ namespace Engine
 		using F32 = float;
 		using F64 = double;
 
-		inline auto operator""_B(const U64 val)   -> U64 { return val; }
-		inline auto operator""_KiB(const U64 val) -> U64 { return 1024llu * val; }
-		inline auto operator""_MiB(const U64 val) -> U64 { return 1024llu * 1024llu * val; }
-		inline auto operator""_GiB(const U64 val) -> U64 { return 1024llu * 1024llu * 1024llu * val; }
+		inline auto operator""_B(unsigned long long val)   -> U64 { return val; }
+		inline auto operator""_KiB(unsigned long long val) -> U64 { return 1024llu * val; }
+		inline auto operator""_MiB(unsigned long long val) -> U64 { return 1024llu * 1024llu * val; }
+		inline auto operator""_GiB(unsigned long long val) -> U64 { return 1024llu * 1024llu * 1024llu * val; }
 	}
 }
 
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "EntityId.h"
+
+#include "Engine/Core/Types.h"
+
+#include <functional>
+
+namespace Engine
+{
+    using namespace Types;
+
+    // List of callbacks of one component pool event (see `Registry::OnConstruct`, `OnDestroy`, `OnUpdate`).
+    // Callbacks shall not connect to or disconnect from the sink they are called by.
+    class ComponentSink
+    {
+    public:
+        using Callback = std::function<void(Entity)>;
+        
+        // Returns id of connection, that is passed to `Disconnect`.
+        U32 Connect(Callback callback);
+        void Disconnect(U32 connectionId);
+        void Publish(Entity entity) const;
+        bool IsEmpty() const { return m_Callbacks.empty(); }
+    private:
+        struct Connection
+        {
+            U32 Id;
+            Callback Fn;
+        };
+        std::vector<Connection> m_Callbacks;
+        U32 m_NextId{0};
+    };
+
+    inline U32 ComponentSink::Connect(Callback callback)
+    {
+        m_Callbacks.push_back({m_NextId, std::move(callback)});
+        return m_NextId++;
+    }
+
+    inline void ComponentSink::Disconnect(U32 connectionId)
+    {
+        std::erase_if(m_Callbacks, [connectionId](const Connection& connection) { return connection.Id == connectionId; });
+    }
+
+    inline void ComponentSink::Publish(Entity entity) const
+    {
+        for (auto& connection : m_Callbacks) connection.Fn(entity);
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+
+namespace Engine
+{
+    // Specialize to change how component is stored.
+    template <typename T>
+    struct ComponentTraits
+    {
+        // If true, removed components leave tombstones instead of being swapped with the last one,
+        // so that pointers and references to other components stay valid (until `Registry::Compact<T>`).
+        // Freed slots are reused by later additions. Such pools cannot be sorted or owned by group.
+        static constexpr bool IN_PLACE_DELETE = false;
+    };
+
+    // Specialize with `static constexpr auto FIELDS = std::make_tuple(&T::A, &T::B, ...);` (every field of `T`)
+    // to store trivially copyable component as structure of arrays: each page of the pool keeps
+    // a separate array for every field, so that they can be processed with SIMD (see `Registry::GetFieldSpan`).
+    // Components of such pools are accessed through `SoaRef<T>` proxy instead of `T&`.
+    template <typename T>
+    struct SoaLayout {};
+
+    template <typename T>
+    concept SoaComponent = requires { SoaLayout<T>::FIELDS; };
+
+    template <typename Member>
+    struct MemberTraits;
+
+    template <typename Class, typename Field>
+    struct MemberTraits<Field Class::*>
+    {
+        using ClassType = Class;
+        using FieldType = Field;
+    };
+}
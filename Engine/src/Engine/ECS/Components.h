@@ -11,6 +11,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include "ComponentTraits.h"
 #include "EntityId.h"
 #include "Engine/Memory/Handle/Handle.h"
 #include "Engine/Physics/RigidBodyEngine/Collision/Contacts.h"
@@ -74,7 +75,7 @@ namespace Engine::Component
     // Placeholder for real camera component which is yet to be added.
     struct Camera
     {
-        Ref<CameraController> CameraController{nullptr};
+        Ref<Engine::CameraController> CameraController{nullptr};
         // TODO: I'm not so sure it belongs here (but they are very tied together).
         Ref<FrameBuffer> CameraFrameBuffer{nullptr};
         bool IsPrimary{false};
@@ -89,7 +90,7 @@ namespace Engine::Component
     {
         glm::vec2 Position{glm::vec2{0.0f}};
         glm::vec2 Scale{glm::vec2{1.0f}};
-        Rotation Rotation{glm::vec2{1.0f, 0.0f}};
+        Engine::Rotation Rotation{glm::vec2{1.0f, 0.0f}};
 
         LocalToWorldTransform2D();
         LocalToWorldTransform2D(const glm::vec2& pos, const glm::vec2& scale, const glm::vec2& rotation);
@@ -109,7 +110,7 @@ namespace Engine::Component
     {
         glm::vec2 Position{glm::vec2{0.0f}};
         glm::vec2 Scale{glm::vec2{1.0f}};
-        Rotation Rotation{glm::vec2{1.0f, 0.0f}};
+        Engine::Rotation Rotation{glm::vec2{1.0f, 0.0f}};
         
         LocalToParentTransform2D();
         LocalToParentTransform2D(const LocalToWorldTransform2D& transform);
@@ -127,6 +128,10 @@ namespace Engine::Component
         Entity Parent{NULL_ENTITY};
         Entity Next{NULL_ENTITY};
         Entity Prev{NULL_ENTITY};
+        // Kept only while hierarchy is flattened (see `SceneGraph::SetFlattenedHierarchy`):
+        // index of parent's `ParentRel` in the pool (-1 for children of top-level entities), and subtree size.
+        I32 ParentIndex{-1};
+        U32 DescendantCount{0};
     };
 
     using PhysicsMaterial = Physics::PhysicsMaterial;
@@ -153,7 +158,7 @@ namespace Engine::Component
         using ColHandle = RefCountHandle<Physics::BoxCollider2D>;
         // Pointer to real (physics engine's) collider.
         ColHandle PhysicsCollider{nullptr};
-        PhysicsMaterial PhysicsMaterial{};
+        Physics::PhysicsMaterial PhysicsMaterial{};
         glm::vec2 Offset{glm::vec2{0.0f}};
         glm::vec2 HalfSize{glm::vec2{0.5f}};
         bool IsSensor{false};
@@ -165,13 +170,13 @@ namespace Engine::Component
 
     struct SpriteRenderer
     {
-        Texture* Texture{nullptr};
+        Engine::Texture* Texture{nullptr};
         std::array<glm::vec2, 4> UV {
             glm::vec2{0.0f, 0.0f}, glm::vec2{1.0f, 0.0f}, glm::vec2{1.0f, 1.0f}, glm::vec2{0.0f, 1.0f}
         };
         glm::vec4 Tint{glm::vec4{1.0f}};
         glm::vec2 Tiling{glm::vec2{1.0f}};
-        SortingLayer::Layer SortingLayer{DefaultSortingLayer.GetDefaultLayer()};
+        Engine::SortingLayer::Layer SortingLayer{DefaultSortingLayer.GetDefaultLayer()};
         I16 OrderInLayer{0};
         bool FlipX{false};
         bool FlipY{false};
@@ -184,11 +189,11 @@ namespace Engine::Component
 
     struct PolygonRenderer
     {
-        Polygon* Polygon{nullptr};
-        Texture* Texture{nullptr};
+        Engine::Polygon* Polygon{nullptr};
+        Engine::Texture* Texture{nullptr};
         glm::vec4 Tint{glm::vec4{1.0f}};
         glm::vec2 Tiling{glm::vec2{1.0f}};
-        SortingLayer::Layer SortingLayer{DefaultSortingLayer.GetDefaultLayer()};
+        Engine::SortingLayer::Layer SortingLayer{DefaultSortingLayer.GetDefaultLayer()};
         I16 OrderInLayer{0};
         bool FlipX{false};
         bool FlipY{false};
@@ -207,12 +212,12 @@ namespace Engine::Component
             glm::vec2 Max{glm::vec2{1.0f}};
         };
 
-        Font* Font{nullptr};
+        Engine::Font* Font{nullptr};
         F32 FontSize{32};
         Rect FontRect{};
         glm::vec4 Tint{glm::vec4{1.0f}};
         F32 Zoom{1.0f};
-        SortingLayer::Layer SortingLayer{DefaultSortingLayer.GetDefaultLayer()};
+        Engine::SortingLayer::Layer SortingLayer{DefaultSortingLayer.GetDefaultLayer()};
         I16 OrderInLayer{0};
 
         FontRenderer(Engine::Font* font, F32 fontSize, const Rect& fontRect, const glm::vec4& tint,
@@ -322,7 +327,7 @@ namespace Engine::Component
         glm::vec4 Tint{};
         glm::vec2 Tiling{};
         std::vector<glm::vec2> UV;
-        Texture* Texture{};
+        Engine::Texture* Texture{};
         //TODO: Most of the parameters one day shall become a part of `Material`.
         GemWarsMesh2D(U32 angles, Engine::Texture* texture, const glm::vec4& tint);
 
@@ -340,3 +345,21 @@ namespace Engine::Component
     struct GemWarsParticleTag
     {};
 }
+
+namespace Engine
+{
+    // Physics bodies and colliders keep pointers to world transforms, so these shall not move on removal.
+    template <>
+    struct ComponentTraits<Component::LocalToWorldTransform2D>
+    {
+        static constexpr bool IN_PLACE_DELETE = true;
+    };
+
+    // Movement and collision systems of GemWars touch only some of the fields of a lot of entities.
+    template <>
+    struct SoaLayout<Component::GemWarsTransform2D>
+    {
+        static constexpr auto FIELDS = std::make_tuple(&Component::GemWarsTransform2D::Position,
+            &Component::GemWarsTransform2D::Scale, &Component::GemWarsTransform2D::Rotation);
+    };
+}
@@ -1,21 +1,331 @@
 #pragma once
 
 #include "Components.h"
+#include "ComponentSink.h"
+#include "ComponentTraits.h"
 #include "EntityId.h"
+#include "EntityManager.h"
 #include "Engine/Common/SparseSetPaged.h"
+#include "Engine/Math/Hash.h"
 
 #include "Engine/Memory/MemoryUtils.h"
 
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
 namespace Engine
 {
     // Used to get all the components unique id.
-    // This may not work sadly.
     class ComponentFamily
     {
-        inline static U64 s_Counter = 0;
+        struct RegistrationTable
+        {
+            std::unordered_map<U64, U64> StableToDense;
+            std::vector<U64> DenseToStable;
+            std::vector<std::string_view> TypeNames;
+        };
+        // Function-local, so that it is initialized before the first `TYPE` that needs it.
+        static RegistrationTable& GetRegistrationTable()
+        {
+            static RegistrationTable table;
+            return table;
+        }
+        template <U64 Capacity>
+        struct TypeNameBuffer
+        {
+            std::array<char, Capacity> Chars{};
+            U64 Size{0};
+            constexpr std::string_view GetView() const { return {Chars.data(), Size}; }
+        };
+        template <typename ComponentType>
+        static constexpr std::string_view GetTypeName();
+        static U64 Register(U64 stableId, std::string_view typeName);
     public:
+        static constexpr U64 NULL_ID = std::numeric_limits<U64>::max();
+
+        // Removes `struct / class / enum` keywords (MSVC keeps them) and whitespace, so that the name
+        // (and its hash) is the same for every compiler.
+        template <U64 Capacity>
+        static constexpr TypeNameBuffer<Capacity> GetCanonicalTypeName(std::string_view typeName);
+    private:
+        template <typename ComponentType>
+        static constexpr auto CANONICAL_TYPE_NAME =
+            GetCanonicalTypeName<GetTypeName<ComponentType>().size()>(GetTypeName<ComponentType>());
+    public:
+        // Hash of type name, the same in every binary and every run, so it can be persisted.
+        template <typename ComponentType>
+        static constexpr U64 STABLE_ID = Math::HashString(CANONICAL_TYPE_NAME<ComponentType>.GetView());
+
+        // Dense id (index of the component pool and of the signature bit),
+        // assigned by the registration table to stable id.
         template <typename ComponentType>
-        inline static const U64 TYPE = s_Counter++;
+        inline static const U64 TYPE = Register(STABLE_ID<ComponentType>, CANONICAL_TYPE_NAME<ComponentType>.GetView());
+
+        // Returns `NULL_ID` if component is not registered.
+        static U64 GetDenseId(U64 stableId);
+        static U64 GetStableId(U64 denseId);
+    };
+
+    template <typename ComponentType>
+    constexpr std::string_view ComponentFamily::GetTypeName()
+    {
+#ifdef _MSC_VER
+        std::string_view signature = __FUNCSIG__;
+        std::string_view prefix = "GetTypeName<";
+        U64 begin = signature.find(prefix) + prefix.size();
+        U64 end = signature.rfind(">(void)");
+#else
+        std::string_view signature = __PRETTY_FUNCTION__;
+        std::string_view prefix = "ComponentType = ";
+        U64 begin = signature.find(prefix) + prefix.size();
+        U64 end = signature.find_first_of(";]", begin);
+#endif
+        return signature.substr(begin, end - begin);
+    }
+
+    template <U64 Capacity>
+    constexpr ComponentFamily::TypeNameBuffer<Capacity> ComponentFamily::GetCanonicalTypeName(std::string_view typeName)
+    {
+        constexpr std::string_view keywords[] = {"struct ", "class ", "enum "};
+        TypeNameBuffer<Capacity> canonical = {};
+        for (U64 i = 0; i < typeName.size(); i++)
+        {
+            char c = typeName[i];
+            char previous = i == 0 ? ' ' : typeName[i - 1];
+            bool isWordStart = !(previous == '_' || (previous >= '0' && previous <= '9') ||
+                (previous >= 'a' && previous <= 'z') || (previous >= 'A' && previous <= 'Z'));
+            if (isWordStart)
+            {
+                bool isKeyword = false;
+                for (auto keyword : keywords)
+                {
+                    if (typeName.substr(i, keyword.size()) != keyword) continue;
+                    i += keyword.size() - 1;
+                    isKeyword = true;
+                    break;
+                }
+                if (isKeyword) continue;
+            }
+            if (c == ' ') continue;
+            canonical.Chars[canonical.Size++] = c;
+        }
+        return canonical;
+    }
+
+    inline U64 ComponentFamily::GetDenseId(U64 stableId)
+    {
+        auto& table = GetRegistrationTable();
+        auto it = table.StableToDense.find(stableId);
+        return it == table.StableToDense.end() ? NULL_ID : it->second;
+    }
+
+    inline U64 ComponentFamily::GetStableId(U64 denseId)
+    {
+        auto& table = GetRegistrationTable();
+        ENGINE_CORE_ASSERT(denseId < table.DenseToStable.size(), "Component is not registered")
+        return table.DenseToStable[denseId];
+    }
+
+    inline U64 ComponentFamily::Register(U64 stableId, std::string_view typeName)
+    {
+        auto& table = GetRegistrationTable();
+        auto it = table.StableToDense.find(stableId);
+        // Collisions and dense id overflow are checked in every configuration (dense id is a bit of `ComponentMask`).
+        // Registration happens during static initialization (before logger is set up), so errors go straight to stderr.
+        if (it != table.StableToDense.end())
+        {
+            const std::string_view registeredName = table.TypeNames[it->second];
+            if (registeredName != typeName)
+            {
+                std::fprintf(stderr, "Component type name hash collision (%.*s and %.*s)\n",
+                    static_cast<I32>(registeredName.size()), registeredName.data(),
+                    static_cast<I32>(typeName.size()), typeName.data());
+                std::abort();
+            }
+            return it->second;
+        }
+        U64 denseId = table.DenseToStable.size();
+        if (denseId >= MAX_COMPONENTS)
+        {
+            std::fprintf(stderr, "Too many component types (registering %.*s), increase MAX_COMPONENTS\n",
+                static_cast<I32>(typeName.size()), typeName.data());
+            std::abort();
+        }
+        table.StableToDense.emplace(stableId, denseId);
+        table.DenseToStable.push_back(stableId);
+        table.TypeNames.push_back(typeName);
+        return denseId;
+    }
+
+    // Layout of structure-of-arrays page (see `SoaLayout`): `SPARSE_SET_PAGE_SIZE` elements of the first field,
+    // followed by the ones of the second field, etc. Since page size is a power of 2, every array is aligned.
+    template <typename T>
+    struct SoaPage
+    {
+        using FieldsTuple = std::remove_const_t<decltype(SoaLayout<T>::FIELDS)>;
+        static constexpr U64 FIELD_COUNT = std::tuple_size_v<FieldsTuple>;
+        template <U64 I>
+        using FieldType = typename MemberTraits<std::tuple_element_t<I, FieldsTuple>>::FieldType;
+
+        static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> && !std::is_empty_v<T>,
+            "Structure-of-arrays component shall be trivially copyable and default constructible");
+
+        template <U64 I>
+        static constexpr U64 GetFieldOffset();
+        // Index of `Member` in `SoaLayout<T>::FIELDS`.
+        template <auto Member, U64 I = 0>
+        static constexpr U64 GetFieldIndex();
+        // Size of all fields of one component (excludes padding of `T`).
+        static constexpr U64 GetFieldsSize() { return GetFieldOffset<FIELD_COUNT>() / SPARSE_SET_PAGE_SIZE; }
+
+        template <U64 I>
+        static FieldType<I>* GetFieldArray(U8* page) { return reinterpret_cast<FieldType<I>*>(page + GetFieldOffset<I>()); }
+        template <U64 I>
+        static const FieldType<I>* GetFieldArray(const U8* page) { return reinterpret_cast<const FieldType<I>*>(page + GetFieldOffset<I>()); }
+
+        static T Load(const U8* page, U32 index);
+        static void Store(U8* page, U32 index, const T& value);
+        static void Copy(const U8* fromPage, U32 fromIndex, U8* toPage, U32 toIndex);
+
+        // Packs first `count` elements of every field to `data` (of `count * GetFieldsSize()` bytes) and back.
+        static void Pack(const U8* page, U32 count, U8* data);
+        static void Unpack(const U8* data, U32 count, U8* page);
+        static bool IsPackedEqual(const U8* page, U32 count, const U8* data);
+
+        static_assert(GetFieldsSize() <= sizeof(T), "Every field of structure-of-arrays component shall be listed once");
+    };
+
+    template <typename T>
+    template <U64 I>
+    constexpr U64 SoaPage<T>::GetFieldOffset()
+    {
+        if constexpr (I == 0) return 0;
+        else return GetFieldOffset<I - 1>() + SPARSE_SET_PAGE_SIZE * sizeof(FieldType<I - 1>);
+    }
+
+    template <typename T>
+    template <auto Member, U64 I>
+    constexpr U64 SoaPage<T>::GetFieldIndex()
+    {
+        static_assert(I < FIELD_COUNT, "Member is not listed in SoaLayout");
+        if constexpr (std::is_same_v<std::tuple_element_t<I, FieldsTuple>, decltype(Member)>)
+        {
+            if constexpr (std::get<I>(SoaLayout<T>::FIELDS) == Member) return I;
+            else return GetFieldIndex<Member, I + 1>();
+        }
+        else
+        {
+            return GetFieldIndex<Member, I + 1>();
+        }
+    }
+
+    template <typename T>
+    T SoaPage<T>::Load(const U8* page, U32 index)
+    {
+        T value{};
+        [&]<U64 ... Is>(std::index_sequence<Is...>)
+        {
+            ((value.*std::get<Is>(SoaLayout<T>::FIELDS) = GetFieldArray<Is>(page)[index]), ...);
+        }(std::make_index_sequence<FIELD_COUNT>{});
+        return value;
+    }
+
+    template <typename T>
+    void SoaPage<T>::Store(U8* page, U32 index, const T& value)
+    {
+        [&]<U64 ... Is>(std::index_sequence<Is...>)
+        {
+            ((GetFieldArray<Is>(page)[index] = value.*std::get<Is>(SoaLayout<T>::FIELDS)), ...);
+        }(std::make_index_sequence<FIELD_COUNT>{});
+    }
+
+    template <typename T>
+    void SoaPage<T>::Copy(const U8* fromPage, U32 fromIndex, U8* toPage, U32 toIndex)
+    {
+        [&]<U64 ... Is>(std::index_sequence<Is...>)
+        {
+            ((GetFieldArray<Is>(toPage)[toIndex] = GetFieldArray<Is>(fromPage)[fromIndex]), ...);
+        }(std::make_index_sequence<FIELD_COUNT>{});
+    }
+
+    template <typename T>
+    void SoaPage<T>::Pack(const U8* page, U32 count, U8* data)
+    {
+        [&]<U64 ... Is>(std::index_sequence<Is...>)
+        {
+            ((MemoryUtils::Copy(data + GetFieldOffset<Is>() / SPARSE_SET_PAGE_SIZE * count, GetFieldArray<Is>(page),
+                count * sizeof(FieldType<Is>))), ...);
+        }(std::make_index_sequence<FIELD_COUNT>{});
+    }
+
+    template <typename T>
+    void SoaPage<T>::Unpack(const U8* data, U32 count, U8* page)
+    {
+        [&]<U64 ... Is>(std::index_sequence<Is...>)
+        {
+            ((MemoryUtils::Copy(GetFieldArray<Is>(page), data + GetFieldOffset<Is>() / SPARSE_SET_PAGE_SIZE * count,
+                count * sizeof(FieldType<Is>))), ...);
+        }(std::make_index_sequence<FIELD_COUNT>{});
+    }
+
+    template <typename T>
+    bool SoaPage<T>::IsPackedEqual(const U8* page, U32 count, const U8* data)
+    {
+        return [&]<U64 ... Is>(std::index_sequence<Is...>)
+        {
+            return ((std::memcmp(GetFieldArray<Is>(page), data + GetFieldOffset<Is>() / SPARSE_SET_PAGE_SIZE * count,
+                count * sizeof(FieldType<Is>)) == 0) && ...);
+        }(std::make_index_sequence<FIELD_COUNT>{});
+    }
+
+    // Proxy reference to component of structure-of-arrays pool (see `SoaLayout`),
+    // converts to (gathers) and assigns from (scatters) `T`, single fields are accessible by reference.
+    // Note: proxy does not carry constness of the pool it was obtained from.
+    template <typename T>
+    class SoaRef
+    {
+    public:
+        SoaRef(U8* page, U32 indexInPage) : m_Page(page), m_Index(indexInPage) {}
+        SoaRef(const SoaRef& other) = default;
+
+        T Load() const { return SoaPage<T>::Load(m_Page, m_Index); }
+        operator T() const { return Load(); }
+
+        const SoaRef& operator=(const T& value) const { SoaPage<T>::Store(m_Page, m_Index, value); return *this; }
+        // Assigns the referenced component, not the reference.
+        const SoaRef& operator=(const SoaRef& other) const { return *this = other.Load(); }
+
+        template <auto Member>
+        auto& Field() const { return SoaPage<T>::template GetFieldArray<SoaPage<T>::template GetFieldIndex<Member>()>(m_Page)[m_Index]; }
+    private:
+        U8* m_Page;
+        U32 m_Index;
+    };
+
+    // What `Get` returns: plain reference, or proxy for structure-of-arrays components.
+    template <typename T>
+    using ComponentRef = std::conditional_t<SoaComponent<T>, SoaRef<T>, T&>;
+    template <typename T>
+    using ConstComponentRef = std::conditional_t<SoaComponent<T>, SoaRef<T>, const T&>;
+
+    class ComponentGroup;
+
+    // Specialize to customize how component is copied into and out of snapshots (see `RegistrySnapshot`),
+    // used only for components that are not trivially copyable (those are copied with raw memcpy).
+    template <typename T>
+    struct ComponentSnapshotTraits
+    {
+        static void Copy(const T& source, void* destination) { new(destination) T(source); }
+    };
+
+    // Copy of component pool's entities and pages.
+    struct ComponentPoolSnapshot
+    {
+        std::vector<Entity> Entities;
+        // Page copies hold only the used part of the page, and may be shared between delta snapshots.
+        std::vector<Ref<U8[]>> Pages;
+        bool IsValid{false};
     };
     
 	class ComponentPool
@@ -26,29 +336,121 @@ namespace Engine
         virtual ~ComponentPool();
 
         template <typename T, typename ... Args>
-        T& Add(Entity entityId, Args&&... args);
+        ComponentRef<T> Add(Entity entityId, Args&&... args);
+        // Adds copy of `prototype` to every entity, all pages are allocated up front
+        // (free slots of pointer-stable pool are reused first).
+        template <typename T>
+        void AddBatch(const std::vector<Entity>& entities, const T& prototype);
 
         bool Has(Entity entityId) const;
         
         template <typename T>
-        const T& Get(Entity entityId) const;
+        ConstComponentRef<T> Get(Entity entityId) const;
         template <typename T>
-        T& Get(Entity entityId);
+        ComponentRef<T> Get(Entity entityId);
 
         template <typename T>
         void Pop(Entity entityId);
 	    virtual void Pop(Entity entityId) = 0;
 
+        // Removes components of all `entities` in one compaction pass (entities w/o component are ignored).
+        template <typename T>
+        void PopBatch(const std::vector<Entity>& entities);
+        virtual void PopBatch(const std::vector<Entity>& entities) = 0;
+
+        // Swaps components (and entities) at `aIndex` and `bIndex`.
+        template <typename T>
+        void Swap(U32 aIndex, U32 bIndex);
+        virtual void Swap(U32 aIndex, U32 bIndex) = 0;
+
+        // Insertion sort (fast for nearly sorted pools), `compare` takes two components or two entities.
+        template <typename T, typename Compare>
+        void Sort(Compare compare);
+        // Moves entities, shared with `other`, to the back of the pool in the same order as in `other`.
+        template <typename T>
+        void SortAs(const ComponentPool& other);
+        // Same as `std::rotate` on dense range [first, last): component at `middle` becomes the one at `first`.
+        template <typename T>
+        void Rotate(U32 first, U32 middle, U32 last);
+        // Moves components of `entities` to the front of the pool in the same order (all of them shall have one).
+        template <typename T>
+        void Arrange(std::span<const Entity> entities);
+
         template <typename T>
-        const T& GetComponent(U32 componentIndex) const;
+        ConstComponentRef<T> GetComponent(U32 componentIndex) const;
         template <typename T>
-        T& GetComponent(U32 componentIndex);
+        ComponentRef<T> GetComponent(U32 componentIndex);
+
+        // Array of `Member` field of page `pageIndex` of structure-of-arrays pool (see `SoaLayout`),
+        // it has an element for every dense slot of the page (including tombstones of pointer-stable pools).
+        template <auto Member>
+        std::span<const typename MemberTraits<decltype(Member)>::FieldType> GetFieldSpan(U32 pageIndex) const;
+        template <auto Member>
+        std::span<typename MemberTraits<decltype(Member)>::FieldType> GetFieldSpan(U32 pageIndex);
+        U32 GetPageCount() const { return (GetComponentCount() + SPARSE_SET_PAGE_SIZE - 1) >> SPARSE_SET_PAGE_SIZE_LOG; }
 
+        // Returns index of entity's component, or `GetNullIndex()` if entity has no such component.
+        U32 TryGetComponentIndex(Entity entityId) const { return m_SparseSet.TryGetIndexOf(entityId); }
+        U32 GetNullIndex() const { return m_SparseSet.GetNullFlag(); }
+
+        // Size of dense array, including tombstones (`NULL_ENTITY`) of pointer-stable pools.
         U32 GetComponentCount() const { return static_cast<U32>(m_SparseSet.GetDense().size()); }
-        const std::vector<Entity> GetDenseEntities() const { return m_SparseSet.GetDense(); }
+        const std::vector<Entity>& GetDenseEntities() const { return m_SparseSet.GetDense(); }
+        // Raised by every change of dense array (components added, removed or swapped),
+        // so that whoever sorts the pool can tell, if it may have become unsorted since.
+        U32 GetLayoutVersion() const { return m_LayoutVersion; }
+
+        // Pointer-stable pools (see `ComponentTraits::IN_PLACE_DELETE`) leave tombstones on removal.
+        bool IsInPlaceDelete() const { return m_IsInPlaceDelete; }
+        U32 GetTombstoneCount() const { return static_cast<U32>(m_FreeSlots.size()); }
+        // Removes tombstones, components are moved (pointers to them are invalidated), but keep their order.
+        template <typename T>
+        void Compact();
+        virtual void Compact() = 0;
+        // Releases pages past the last component, and unused capacity (tombstones are kept, see `Compact`).
+        void ShrinkToFit();
 
 	    void SetDebugName(const std::string& name) { m_DebugName = name; }
 	    const std::string& GetDebugName() const { return m_DebugName; }
+
+	    ComponentGroup* GetOwningGroup() const { return m_OwningGroup; }
+	    void SetOwningGroup(ComponentGroup* group) { m_OwningGroup = group; }
+
+        // Published after component was added, before it is removed, and when it is marked changed (by `Registry::MarkChanged`).
+        ComponentSink& GetOnConstruct() { return m_OnConstruct; }
+        ComponentSink& GetOnDestroy() { return m_OnDestroy; }
+        ComponentSink& GetOnUpdate() { return m_OnUpdate; }
+
+        // Every component, page and the pool itself keep the tick of their last change
+        // (page and pool ticks are the maximum of the ticks of their components).
+        // Components of different entities may be marked concurrently (page and pool ticks are raised atomically).
+        void MarkChanged(U32 componentIndex, U32 tick);
+        U32 GetChangeTick() const { return m_ChangeTick; }
+        U32 GetPageChangeTick(U32 pageIndex) const { return m_PageChangeTicks[pageIndex]; }
+        U32 GetComponentChangeTick(U32 componentIndex) const { return m_ChangeTicks[componentIndex]; }
+
+        // Copies entities and components to `snapshot`, pages equal to the ones of `base` are shared with it.
+        void SaveSnapshot(ComponentPoolSnapshot& snapshot, const ComponentPoolSnapshot* base) const;
+        // Replaces pool contents with the ones of `snapshot`, every component is stamped with `tick`.
+        void RestoreSnapshot(const ComponentPoolSnapshot& snapshot, U32 tick);
+
+        // Destroys all components.
+        template <typename T>
+        void Clear();
+        virtual void Clear() = 0;
+
+        // Returns copy of first `count` components of page (nullptr for empty components).
+        template <typename T>
+        Ref<U8[]> CopyPage(U32 pageIndex, U32 count) const;
+        virtual Ref<U8[]> CopyPage(U32 pageIndex, U32 count) const = 0;
+        // Copies `count` components from `data` (made by `CopyPage`) to page.
+        template <typename T>
+        void RestorePage(U32 pageIndex, U32 count, const U8* data);
+        virtual void RestorePage(U32 pageIndex, U32 count, const U8* data) = 0;
+        // Always false for components, that are not trivially copyable.
+        template <typename T>
+        bool IsPageEqual(U32 pageIndex, U32 count, const U8* data) const;
+        virtual bool IsPageEqual(U32 pageIndex, U32 count, const U8* data) const = 0;
 	    
     private:
         U8* GetOrCreate(U32 index);
@@ -57,12 +459,43 @@ namespace Engine
 	    template <typename T>
         void PopWithComponent(Entity entityId);
         void* GetComponentAddress(U32 componentIndex) const;
+        // Component memory operations (field-wise for structure-of-arrays components, no-op for empty ones).
+        template <typename T, typename ... Args>
+        void ConstructComponent(U32 componentIndex, Args&&... args);
+        template <typename T>
+        void DestroyComponent(U32 componentIndex);
+        // Moves component from `from` to (uninitialized) `to`, the one at `from` is destroyed.
+        template <typename T>
+        void RelocateComponent(U32 from, U32 to);
+        template <typename T>
+        void SwapComponents(U32 aIndex, U32 bIndex);
+        void SwapChangeTicks(U32 aIndex, U32 bIndex);
+        static void RaiseTick(U32& tick, U32 value);
+        // Number of components in page `pageIndex`, if pool has `count` components.
+        static U32 GetPageComponentCount(U32 count, U32 pageIndex);
+    protected:
+        bool m_IsInPlaceDelete{false};
     private:
         std::vector<U8*> m_ComponentsPaged;
         U32 m_TypeSizeBytes{};
         SparseSetPaged<U32, Entity, EntityIdDecomposer> m_SparseSet;
 
 	    std::string m_DebugName{"Default"};
+	    // Group that keeps this pool sorted (if any).
+	    ComponentGroup* m_OwningGroup{nullptr};
+
+        // Parallel to dense array.
+        std::vector<U32> m_ChangeTicks;
+        std::vector<U32> m_PageChangeTicks;
+        U32 m_ChangeTick{0};
+        U32 m_LayoutVersion{0};
+
+        // Dense slots of removed components of pointer-stable pool, reused by `Add`.
+        std::vector<U32> m_FreeSlots;
+
+        ComponentSink m_OnConstruct;
+        ComponentSink m_OnDestroy;
+        ComponentSink m_OnUpdate;
     };
 
     inline ComponentPool::ComponentPool(U32 typeSizeBytes)
@@ -71,38 +504,165 @@ namespace Engine
     }
 
     template <typename T, typename ... Args>
-    T& ComponentPool::Add(Entity entityId, Args&&... args)
+    ComponentRef<T> ComponentPool::Add(Entity entityId, Args&&... args)
     {
-        U32 componentIndex = m_SparseSet.Push(entityId);
-        U8* componentPage = GetOrCreate(componentIndex);
-        void* componentAddress = componentPage + static_cast<U64>(m_TypeSizeBytes * Math::FastMod(componentIndex, SPARSE_SET_PAGE_SIZE));
-        new(componentAddress) T(std::forward<Args>(args)...);
-        return *static_cast<T*>(componentAddress);
+        m_LayoutVersion++;
+        U32 componentIndex;
+        if (!m_FreeSlots.empty())
+        {
+            componentIndex = m_SparseSet.PushAt(entityId, m_FreeSlots.back());
+            m_FreeSlots.pop_back();
+        }
+        else
+        {
+            componentIndex = m_SparseSet.Push(entityId);
+            m_ChangeTicks.push_back(0);
+            U32 pageNum = componentIndex >> SPARSE_SET_PAGE_SIZE_LOG;
+            if (pageNum >= m_PageChangeTicks.size()) m_PageChangeTicks.resize(pageNum + 1);
+        }
+        // Empty components (tags) have no payload, only the sparse set is kept.
+        if constexpr (!std::is_empty_v<T>) GetOrCreate(componentIndex);
+        ConstructComponent<T>(componentIndex, std::forward<Args>(args)...);
+        return GetComponent<T>(componentIndex);
     }
 
     template <typename T>
-    const T& ComponentPool::Get(Entity entityId) const
+    void ComponentPool::AddBatch(const std::vector<Entity>& entities, const T& prototype)
+    {
+        if (entities.empty()) return;
+        m_LayoutVersion++;
+        // Tombstones of pointer-stable pool are reused first, as in `Add`.
+        U32 reusedCount = std::min(static_cast<U32>(m_FreeSlots.size()), static_cast<U32>(entities.size()));
+        for (U32 i = 0; i < reusedCount; i++)
+        {
+            U32 componentIndex = m_SparseSet.PushAt(entities[i], m_FreeSlots.back());
+            m_FreeSlots.pop_back();
+            if constexpr (!std::is_empty_v<T>)
+            {
+                GetOrCreate(componentIndex);
+                ConstructComponent<T>(componentIndex, prototype);
+            }
+        }
+        if (reusedCount == entities.size()) return;
+        U32 firstIndex = GetComponentCount();
+        U32 lastIndex = firstIndex + static_cast<U32>(entities.size()) - reusedCount - 1;
+        m_SparseSet.Reserve(lastIndex + 1);
+        for (U32 i = reusedCount; i < entities.size(); i++) m_SparseSet.Push(entities[i]);
+        m_ChangeTicks.resize(lastIndex + 1);
+        m_PageChangeTicks.resize(std::max(static_cast<U32>(m_PageChangeTicks.size()), (lastIndex >> SPARSE_SET_PAGE_SIZE_LOG) + 1));
+        if constexpr (!std::is_empty_v<T>)
+        {
+            for (U32 page = firstIndex >> SPARSE_SET_PAGE_SIZE_LOG; page <= lastIndex >> SPARSE_SET_PAGE_SIZE_LOG; page++)
+            {
+                GetOrCreate(page << SPARSE_SET_PAGE_SIZE_LOG);
+            }
+            for (U32 i = firstIndex; i <= lastIndex; i++) ConstructComponent<T>(i, prototype);
+        }
+    }
+
+    template <typename T>
+    ConstComponentRef<T> ComponentPool::Get(Entity entityId) const
     {
         U32 componentIndex = m_SparseSet.GetIndexOf(entityId);
         return GetComponent<T>(componentIndex);
     }
 
     template <typename T>
-    T& ComponentPool::Get(Entity entityId)
+    ComponentRef<T> ComponentPool::Get(Entity entityId)
+    {
+        return GetComponent<T>(m_SparseSet.GetIndexOf(entityId));
+    }
+
+    template <typename T>
+    ConstComponentRef<T> ComponentPool::GetComponent(U32 componentIndex) const
+    {
+        if constexpr (std::is_empty_v<T>)
+        {
+            // All empty components share the same instance.
+            static T instance{};
+            return instance;
+        }
+        else if constexpr (SoaComponent<T>)
+        {
+            return SoaRef<T>(const_cast<U8*>(TryGet(componentIndex)), Math::FastMod(componentIndex, SPARSE_SET_PAGE_SIZE));
+        }
+        else
+        {
+            return *static_cast<T*>(GetComponentAddress(componentIndex));
+        }
+    }
+
+    template <typename T>
+    ComponentRef<T> ComponentPool::GetComponent(U32 componentIndex)
+    {
+        if constexpr (SoaComponent<T>) return const_cast<const ComponentPool*>(this)->GetComponent<T>(componentIndex);
+        else return const_cast<T&>(const_cast<const ComponentPool*>(this)->GetComponent<T>(componentIndex));
+    }
+
+    template <auto Member>
+    std::span<const typename MemberTraits<decltype(Member)>::FieldType> ComponentPool::GetFieldSpan(U32 pageIndex) const
+    {
+        using T = typename MemberTraits<decltype(Member)>::ClassType;
+        static_assert(SoaComponent<T>, "Component is not stored as structure of arrays, specialize SoaLayout");
+        ENGINE_CORE_ASSERT(pageIndex < GetPageCount(), "Page index out of bounds")
+        const U8* page = TryGet(pageIndex << SPARSE_SET_PAGE_SIZE_LOG);
+        return {SoaPage<T>::template GetFieldArray<SoaPage<T>::template GetFieldIndex<Member>()>(page),
+            GetPageComponentCount(GetComponentCount(), pageIndex)};
+    }
+
+    template <auto Member>
+    std::span<typename MemberTraits<decltype(Member)>::FieldType> ComponentPool::GetFieldSpan(U32 pageIndex)
+    {
+        using Field = typename MemberTraits<decltype(Member)>::FieldType;
+        auto span = const_cast<const ComponentPool*>(this)->GetFieldSpan<Member>(pageIndex);
+        return {const_cast<Field*>(span.data()), span.size()};
+    }
+
+    template <typename T, typename ... Args>
+    void ComponentPool::ConstructComponent(U32 componentIndex, Args&&... args)
     {
-        return const_cast<T&>(const_cast<const ComponentPool*>(this)->Get<T>(entityId));
+        if constexpr (std::is_empty_v<T>) return;
+        else if constexpr (SoaComponent<T>)
+            SoaPage<T>::Store(TryGet(componentIndex), Math::FastMod(componentIndex, SPARSE_SET_PAGE_SIZE), T(std::forward<Args>(args)...));
+        else new(GetComponentAddress(componentIndex)) T(std::forward<Args>(args)...);
     }
 
     template <typename T>
-    const T& ComponentPool::GetComponent(U32 componentIndex) const
+    void ComponentPool::DestroyComponent(U32 componentIndex)
     {
-        return *static_cast<T*>(GetComponentAddress(componentIndex));
+        if constexpr (!std::is_empty_v<T> && !SoaComponent<T>) static_cast<T*>(GetComponentAddress(componentIndex))->~T();
     }
 
     template <typename T>
-    T& ComponentPool::GetComponent(U32 componentIndex)
+    void ComponentPool::RelocateComponent(U32 from, U32 to)
     {
-        return const_cast<T&>(const_cast<const ComponentPool*>(this)->GetComponent<T>(componentIndex));
+        if constexpr (std::is_empty_v<T>) return;
+        else if constexpr (SoaComponent<T>)
+        {
+            SoaPage<T>::Copy(TryGet(from), Math::FastMod(from, SPARSE_SET_PAGE_SIZE), TryGet(to), Math::FastMod(to, SPARSE_SET_PAGE_SIZE));
+        }
+        else
+        {
+            T* fromAddress = static_cast<T*>(GetComponentAddress(from));
+            new(GetComponentAddress(to)) T(std::move(*fromAddress));
+            fromAddress->~T();
+        }
+    }
+
+    template <typename T>
+    void ComponentPool::SwapComponents(U32 aIndex, U32 bIndex)
+    {
+        if constexpr (std::is_empty_v<T>) return;
+        else if constexpr (SoaComponent<T>)
+        {
+            T a = GetComponent<T>(aIndex);
+            GetComponent<T>(aIndex) = GetComponent<T>(bIndex).Load();
+            GetComponent<T>(bIndex) = a;
+        }
+        else
+        {
+            std::swap(GetComponent<T>(aIndex), GetComponent<T>(bIndex));
+        }
     }
 
     template <typename T>
@@ -116,20 +676,349 @@ namespace Engine
     template <typename T>
     void ComponentPool::PopWithComponent(Entity entityId)
     {
+        m_LayoutVersion++;
+        if constexpr (ComponentTraits<T>::IN_PLACE_DELETE)
+        {
+            U32 index = m_SparseSet.PopInPlace(entityId, NULL_ENTITY);
+            DestroyComponent<T>(index);
+            m_FreeSlots.push_back(index);
+            return;
+        }
         auto popCallback = [this](U32 index)
         {
-            void* address = GetComponentAddress(index);
-            static_cast<T*>(address)->~T();
+            DestroyComponent<T>(index);
+            m_ChangeTicks.pop_back();
         };
         auto swapCallback = [this](U32 a, U32 b)
         {
-            void* aAddress = GetComponentAddress(a);
-            void* bAddress = GetComponentAddress(b);
-            std::swap(*static_cast<T*>(aAddress), *static_cast<T*>(bAddress));
+            SwapComponents<T>(a, b);
+            SwapChangeTicks(a, b);
         };
         m_SparseSet.Pop(entityId, popCallback, swapCallback);
     }
     
+    template <typename T>
+    void ComponentPool::PopBatch(const std::vector<Entity>& entities)
+    {
+        if constexpr (ComponentTraits<T>::IN_PLACE_DELETE)
+        {
+            // Nothing is moved, so there is nothing to batch.
+            for (auto e : entities)
+            {
+                if (m_SparseSet.Has(e)) PopWithComponent<T>(e);
+            }
+            return;
+        }
+        std::vector<U32> indices;
+        indices.reserve(entities.size());
+        for (auto e : entities)
+        {
+            U32 index = m_SparseSet.TryGetIndexOf(e);
+            if (index != m_SparseSet.GetNullFlag()) indices.push_back(index);
+        }
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        if (!indices.empty()) m_LayoutVersion++;
+        auto popCallback = [this](U32 index) { DestroyComponent<T>(index); };
+        auto moveCallback = [this](U32 from, U32 to)
+        {
+            RelocateComponent<T>(from, to);
+            MarkChanged(to, m_ChangeTicks[from]);
+        };
+        m_SparseSet.PopBatch(indices, popCallback, moveCallback);
+        m_ChangeTicks.resize(GetComponentCount());
+    }
+
+    template <typename T>
+    void ComponentPool::Compact()
+    {
+        if (m_FreeSlots.empty()) return;
+        m_LayoutVersion++;
+        std::sort(m_FreeSlots.begin(), m_FreeSlots.end());
+        // Components of tombstones are already destroyed.
+        auto popCallback = [](U32) {};
+        auto moveCallback = [this](U32 from, U32 to)
+        {
+            RelocateComponent<T>(from, to);
+            MarkChanged(to, m_ChangeTicks[from]);
+        };
+        m_SparseSet.PopBatch(m_FreeSlots, popCallback, moveCallback);
+        m_ChangeTicks.resize(GetComponentCount());
+        m_FreeSlots.clear();
+    }
+
+    template <typename T>
+    void ComponentPool::Swap(U32 aIndex, U32 bIndex)
+    {
+        if (aIndex == bIndex) return;
+        m_LayoutVersion++;
+        SwapComponents<T>(aIndex, bIndex);
+        m_SparseSet.Swap(aIndex, bIndex);
+        SwapChangeTicks(aIndex, bIndex);
+    }
+
+    template <typename T, typename Compare>
+    void ComponentPool::Sort(Compare compare)
+    {
+        ENGINE_CORE_ASSERT(m_OwningGroup == nullptr, "Cannot sort pool, that is owned by group")
+        ENGINE_CORE_ASSERT(!m_IsInPlaceDelete, "Cannot sort pointer-stable pool")
+        auto isLess = [this, &compare](U32 a, U32 b)
+        {
+            if constexpr (std::is_invocable_v<Compare&, const T&, const T&>)
+            {
+                return compare(GetComponent<T>(a), GetComponent<T>(b));
+            }
+            else
+            {
+                return compare(GetDenseEntities()[a], GetDenseEntities()[b]);
+            }
+        };
+        for (U32 i = 1; i < GetComponentCount(); i++)
+        {
+            for (U32 j = i; j > 0 && isLess(j, j - 1); j--)
+            {
+                Swap<T>(j, j - 1);
+            }
+        }
+    }
+
+    template <typename T>
+    void ComponentPool::SortAs(const ComponentPool& other)
+    {
+        ENGINE_CORE_ASSERT(m_OwningGroup == nullptr, "Cannot sort pool, that is owned by group")
+        ENGINE_CORE_ASSERT(!m_IsInPlaceDelete, "Cannot sort pointer-stable pool")
+        if (GetComponentCount() == 0) return;
+        U32 position = GetComponentCount() - 1;
+        const auto& otherEntities = other.GetDenseEntities();
+        for (I32 i = static_cast<I32>(otherEntities.size()) - 1; i >= 0; i--)
+        {
+            U32 index = TryGetComponentIndex(otherEntities[i]);
+            if (index == GetNullIndex()) continue;
+            Swap<T>(index, position);
+            if (position-- == 0) break;
+        }
+    }
+
+    template <typename T>
+    void ComponentPool::Rotate(U32 first, U32 middle, U32 last)
+    {
+        ENGINE_CORE_ASSERT(m_OwningGroup == nullptr, "Cannot sort pool, that is owned by group")
+        ENGINE_CORE_ASSERT(!m_IsInPlaceDelete, "Cannot sort pointer-stable pool")
+        ENGINE_CORE_ASSERT(first <= middle && middle <= last && last <= GetComponentCount(), "Invalid rotation range")
+        if (first == middle || middle == last) return;
+        // Three reversals, every component is swapped at most twice.
+        auto reverse = [this](U32 begin, U32 end)
+        {
+            while (begin + 1 < end) Swap<T>(begin++, --end);
+        };
+        reverse(first, middle);
+        reverse(middle, last);
+        reverse(first, last);
+    }
+
+    template <typename T>
+    void ComponentPool::Arrange(std::span<const Entity> entities)
+    {
+        ENGINE_CORE_ASSERT(m_OwningGroup == nullptr, "Cannot sort pool, that is owned by group")
+        ENGINE_CORE_ASSERT(!m_IsInPlaceDelete, "Cannot sort pointer-stable pool")
+        for (U32 i = 0; i < entities.size(); i++)
+        {
+            U32 index = TryGetComponentIndex(entities[i]);
+            ENGINE_CORE_ASSERT(index != GetNullIndex(), "Entity has no such component")
+            Swap<T>(index, i);
+        }
+    }
+
+    template <typename T>
+    void ComponentPool::Clear()
+    {
+        if constexpr (!std::is_empty_v<T> && !SoaComponent<T>)
+        {
+            for (U32 i = 0; i < GetComponentCount(); i++)
+            {
+                if (GetDenseEntities()[i] != NULL_ENTITY) DestroyComponent<T>(i);
+            }
+        }
+        m_SparseSet.Clear();
+        m_ChangeTicks.clear();
+        m_FreeSlots.clear();
+        m_LayoutVersion++;
+    }
+
+    template <typename T>
+    Ref<U8[]> ComponentPool::CopyPage(U32 pageIndex, U32 count) const
+    {
+        if constexpr (std::is_empty_v<T>)
+        {
+            return nullptr;
+        }
+        else
+        {
+            const U8* page = m_ComponentsPaged[pageIndex];
+            U64 sizeBytes = static_cast<U64>(count) * sizeof(T);
+            if constexpr (SoaComponent<T>)
+            {
+                // Used part of every field array, packed one after another.
+                sizeBytes = static_cast<U64>(count) * SoaPage<T>::GetFieldsSize();
+                Ref<U8[]> copy(NewArr<U8>(sizeBytes), [sizeBytes](U8* data) { DeleteArr(data, sizeBytes); });
+                SoaPage<T>::Pack(page, count, copy.get());
+                return copy;
+            }
+            else if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                Ref<U8[]> copy(NewArr<U8>(sizeBytes), [sizeBytes](U8* data) { DeleteArr(data, sizeBytes); });
+                MemoryUtils::Copy(copy.get(), page, sizeBytes);
+                return copy;
+            }
+            else
+            {
+                // Tombstones (of pointer-stable pools) are neither copied nor destroyed.
+                const Entity* entities = GetDenseEntities().data() + (pageIndex << SPARSE_SET_PAGE_SIZE_LOG);
+                std::vector<bool> isAlive(count);
+                for (U32 i = 0; i < count; i++) isAlive[i] = entities[i] != NULL_ENTITY;
+                U8* data = NewArr<U8>(sizeBytes);
+                for (U32 i = 0; i < count; i++)
+                {
+                    if (isAlive[i]) ComponentSnapshotTraits<T>::Copy(reinterpret_cast<const T*>(page)[i], data + i * sizeof(T));
+                }
+                return Ref<U8[]>(data, [isAlive = std::move(isAlive), sizeBytes](U8* data)
+                {
+                    for (U32 i = 0; i < isAlive.size(); i++)
+                    {
+                        if (isAlive[i]) reinterpret_cast<T*>(data)[i].~T();
+                    }
+                    DeleteArr(data, sizeBytes);
+                });
+            }
+        }
+    }
+
+    template <typename T>
+    void ComponentPool::RestorePage(U32 pageIndex, U32 count, const U8* data)
+    {
+        if constexpr (!std::is_empty_v<T>)
+        {
+            U8* page = GetOrCreate(pageIndex << SPARSE_SET_PAGE_SIZE_LOG);
+            if constexpr (SoaComponent<T>)
+            {
+                SoaPage<T>::Unpack(data, count, page);
+            }
+            else if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                MemoryUtils::Copy(page, data, static_cast<U64>(count) * sizeof(T));
+            }
+            else
+            {
+                const Entity* entities = GetDenseEntities().data() + (pageIndex << SPARSE_SET_PAGE_SIZE_LOG);
+                for (U32 i = 0; i < count; i++)
+                {
+                    if (entities[i] == NULL_ENTITY) continue;
+                    ComponentSnapshotTraits<T>::Copy(reinterpret_cast<const T*>(data)[i], page + i * sizeof(T));
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    bool ComponentPool::IsPageEqual(U32 pageIndex, U32 count, const U8* data) const
+    {
+        if constexpr (std::is_empty_v<T> || !std::is_trivially_copyable_v<T>)
+        {
+            return false;
+        }
+        else if constexpr (SoaComponent<T>)
+        {
+            return SoaPage<T>::IsPackedEqual(m_ComponentsPaged[pageIndex], count, data);
+        }
+        else
+        {
+            return std::memcmp(m_ComponentsPaged[pageIndex], data, static_cast<U64>(count) * sizeof(T)) == 0;
+        }
+    }
+
+    inline void ComponentPool::SaveSnapshot(ComponentPoolSnapshot& snapshot, const ComponentPoolSnapshot* base) const
+    {
+        snapshot.IsValid = true;
+        snapshot.Entities = GetDenseEntities();
+        U32 count = GetComponentCount();
+        U32 pageCount = (count + SPARSE_SET_PAGE_SIZE - 1) >> SPARSE_SET_PAGE_SIZE_LOG;
+        snapshot.Pages.assign(pageCount, nullptr);
+        U32 baseCount = base != nullptr ? static_cast<U32>(base->Entities.size()) : 0;
+        for (U32 page = 0; page < pageCount; page++)
+        {
+            U32 pageComponents = GetPageComponentCount(count, page);
+            bool isShared = base != nullptr && page < base->Pages.size() && base->Pages[page] != nullptr &&
+                GetPageComponentCount(baseCount, page) == pageComponents &&
+                IsPageEqual(page, pageComponents, base->Pages[page].get());
+            snapshot.Pages[page] = isShared ? base->Pages[page] : CopyPage(page, pageComponents);
+        }
+    }
+
+    inline void ComponentPool::RestoreSnapshot(const ComponentPoolSnapshot& snapshot, U32 tick)
+    {
+        Clear();
+        m_SparseSet.Reserve(static_cast<U32>(snapshot.Entities.size()));
+        for (auto e : snapshot.Entities)
+        {
+            if (e != NULL_ENTITY) m_SparseSet.Push(e);
+            else m_FreeSlots.push_back(m_SparseSet.PushTombstone(NULL_ENTITY));
+        }
+        U32 count = GetComponentCount();
+        U32 pageCount = static_cast<U32>(snapshot.Pages.size());
+        for (U32 page = 0; page < pageCount; page++)
+        {
+            RestorePage(page, GetPageComponentCount(count, page), snapshot.Pages[page].get());
+        }
+        // Restored components differ from what systems have seen, so all of them are marked as changed.
+        m_ChangeTicks.assign(count, tick);
+        if (pageCount > m_PageChangeTicks.size()) m_PageChangeTicks.resize(pageCount);
+        for (U32 page = 0; page < pageCount; page++) m_PageChangeTicks[page] = std::max(m_PageChangeTicks[page], tick);
+        m_ChangeTick = std::max(m_ChangeTick, tick);
+    }
+
+    inline void ComponentPool::ShrinkToFit()
+    {
+        U32 pageCount = GetPageCount();
+        for (U32 page = pageCount; page < m_ComponentsPaged.size(); page++)
+        {
+            if (m_ComponentsPaged[page]) DeleteArr(m_ComponentsPaged[page], static_cast<U32>(SPARSE_SET_PAGE_SIZE * m_TypeSizeBytes));
+        }
+        m_ComponentsPaged.resize(std::min(pageCount, static_cast<U32>(m_ComponentsPaged.size())));
+        m_ComponentsPaged.shrink_to_fit();
+        m_PageChangeTicks.resize(std::min(pageCount, static_cast<U32>(m_PageChangeTicks.size())));
+        m_PageChangeTicks.shrink_to_fit();
+        m_ChangeTicks.shrink_to_fit();
+        m_FreeSlots.shrink_to_fit();
+        m_SparseSet.ShrinkToFit();
+    }
+
+    inline U32 ComponentPool::GetPageComponentCount(U32 count, U32 pageIndex)
+    {
+        U32 pageBegin = pageIndex << SPARSE_SET_PAGE_SIZE_LOG;
+        return pageBegin >= count ? 0 : std::min(SPARSE_SET_PAGE_SIZE, count - pageBegin);
+    }
+
+    inline void ComponentPool::MarkChanged(U32 componentIndex, U32 tick)
+    {
+        std::atomic_ref(m_ChangeTicks[componentIndex]).store(tick, std::memory_order_relaxed);
+        RaiseTick(m_PageChangeTicks[componentIndex >> SPARSE_SET_PAGE_SIZE_LOG], tick);
+        RaiseTick(m_ChangeTick, tick);
+    }
+
+    inline void ComponentPool::RaiseTick(U32& tick, U32 value)
+    {
+        std::atomic_ref atomicTick(tick);
+        U32 current = atomicTick.load(std::memory_order_relaxed);
+        while (current < value && !atomicTick.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    inline void ComponentPool::SwapChangeTicks(U32 aIndex, U32 bIndex)
+    {
+        U32 aTick = m_ChangeTicks[aIndex];
+        MarkChanged(aIndex, m_ChangeTicks[bIndex]);
+        MarkChanged(bIndex, aTick);
+    }
+
     inline void* ComponentPool::GetComponentAddress(U32 componentIndex) const
     {
         const U8* componentPage = TryGet(componentIndex);
@@ -188,12 +1077,20 @@ namespace Engine
     public:
         TComponentPool(U32 typeSizeBytes);
         void Pop(Entity entityId) override;
+        void PopBatch(const std::vector<Entity>& entities) override;
+        void Swap(U32 aIndex, U32 bIndex) override;
+        void Clear() override;
+        Ref<U8[]> CopyPage(U32 pageIndex, U32 count) const override;
+        void RestorePage(U32 pageIndex, U32 count, const U8* data) override;
+        bool IsPageEqual(U32 pageIndex, U32 count, const U8* data) const override;
+        void Compact() override;
     };
 
     template <typename T>
     TComponentPool<T>::TComponentPool(U32 typeSizeBytes)
         : ComponentPool(typeSizeBytes)
     {
+        m_IsInPlaceDelete = ComponentTraits<T>::IN_PLACE_DELETE;
     }
 
     template <typename T>
@@ -201,24 +1098,142 @@ namespace Engine
     {
         static_cast<ComponentPool*>(this)->Pop<T>(entityId);
     }
+
+    template <typename T>
+    void TComponentPool<T>::PopBatch(const std::vector<Entity>& entities)
+    {
+        static_cast<ComponentPool*>(this)->PopBatch<T>(entities);
+    }
+
+    template <typename T>
+    void TComponentPool<T>::Swap(U32 aIndex, U32 bIndex)
+    {
+        static_cast<ComponentPool*>(this)->Swap<T>(aIndex, bIndex);
+    }
+
+    template <typename T>
+    void TComponentPool<T>::Clear()
+    {
+        static_cast<ComponentPool*>(this)->Clear<T>();
+    }
+
+    template <typename T>
+    Ref<U8[]> TComponentPool<T>::CopyPage(U32 pageIndex, U32 count) const
+    {
+        return static_cast<const ComponentPool*>(this)->CopyPage<T>(pageIndex, count);
+    }
+
+    template <typename T>
+    void TComponentPool<T>::RestorePage(U32 pageIndex, U32 count, const U8* data)
+    {
+        static_cast<ComponentPool*>(this)->RestorePage<T>(pageIndex, count, data);
+    }
+
+    template <typename T>
+    void TComponentPool<T>::Compact()
+    {
+        static_cast<ComponentPool*>(this)->Compact<T>();
+    }
+
+    template <typename T>
+    bool TComponentPool<T>::IsPageEqual(U32 pageIndex, U32 count, const U8* data) const
+    {
+        return static_cast<const ComponentPool*>(this)->IsPageEqual<T>(pageIndex, count, data);
+    }
+
+    // Owning group keeps entities, that have all of the group's components,
+    // in the first `GetSize()` slots of every owned pool, in the same order,
+    // so that they can be iterated in lockstep without any lookups.
+    // Note: adding / removing owned component may move other owned components of the same entity.
+    class ComponentGroup
+    {
+        friend class Registry;
+    public:
+        ComponentGroup(const std::vector<ComponentPool*>& pools);
+
+        // Shall be called after owned component was added to entity.
+        void OnAdd(Entity entityId);
+        // Shall be called before owned component is removed from entity.
+        void OnRemove(Entity entityId);
+
+        U32 GetSize() const { return m_Size; }
+        const std::vector<ComponentPool*>& GetPools() const { return m_Pools; }
+    private:
+        bool IsInAllPools(Entity entityId) const;
+    private:
+        std::vector<ComponentPool*> m_Pools;
+        U32 m_Size{0};
+    };
+
+    inline ComponentGroup::ComponentGroup(const std::vector<ComponentPool*>& pools)
+        : m_Pools(pools)
+    {
+        for (auto* pool : m_Pools)
+        {
+            ENGINE_CORE_ASSERT(pool->GetOwningGroup() == nullptr, "Component is already owned by another group")
+            ENGINE_CORE_ASSERT(!pool->IsInPlaceDelete(), "Pointer-stable pool cannot be owned by group")
+            pool->SetOwningGroup(this);
+        }
+        // Pack entities that are already in all pools.
+        const auto& entities = m_Pools.front()->GetDenseEntities();
+        for (U32 i = 0; i < entities.size(); i++)
+        {
+            OnAdd(entities[i]);
+        }
+    }
+
+    inline void ComponentGroup::OnAdd(Entity entityId)
+    {
+        if (!IsInAllPools(entityId)) return;
+        if (m_Pools.front()->TryGetComponentIndex(entityId) < m_Size) return;
+        for (auto* pool : m_Pools)
+        {
+            pool->Swap(pool->TryGetComponentIndex(entityId), m_Size);
+        }
+        m_Size++;
+    }
+
+    inline void ComponentGroup::OnRemove(Entity entityId)
+    {
+        U32 index = m_Pools.front()->TryGetComponentIndex(entityId);
+        if (index == m_Pools.front()->GetNullIndex() || index >= m_Size) return;
+        m_Size--;
+        for (auto* pool : m_Pools)
+        {
+            pool->Swap(pool->TryGetComponentIndex(entityId), m_Size);
+        }
+    }
+
+    inline bool ComponentGroup::IsInAllPools(Entity entityId) const
+    {
+        for (auto* pool : m_Pools)
+        {
+            if (!pool->Has(entityId)) return false;
+        }
+        return true;
+    }
     
     class ComponentManager
     {
         friend class Registry;
     public:
         template <typename T, typename ... Args>
-        T& Add(Entity entityId, Args&&... args);
+        ComponentRef<T> Add(Entity entityId, Args&&... args);
+        template <typename T>
+        void AddBatch(const std::vector<Entity>& entities, const T& prototype);
 
         template <typename T>
         void Remove(Entity entityId);
+        // Removes component from all `entities` (that have it) in one pass.
+        void RemoveBatch(U64 componentId, const std::vector<Entity>& entities);
 
         template <typename T>
         bool Has(Entity entityId);
 
         template <typename T>
-        const T& Get(Entity entityId) const;
+        ConstComponentRef<T> Get(Entity entityId) const;
         template <typename T>
-        T& Get(Entity entityId);
+        ComponentRef<T> Get(Entity entityId);
 
         bool DoesPoolExist(U64 componentId) const;
         
@@ -229,8 +1244,20 @@ namespace Engine
         std::vector<Ref<ComponentPool>>& GetPools() { return m_Pools; }
         U32 GetPoolCount() const { return static_cast<U32>(m_Pools.size()); }
 
+        // Returns the group that owns all `Cmpts` (creates it if it does not exist yet).
+        template <typename ... Cmpts>
+        ComponentGroup& GetOrCreateGroup();
+
+        U32 GetChangeTick() const { return m_ChangeTick; }
+
+    private:
+        template <typename T>
+        ComponentPool& GetOrCreatePool();
     private:
         std::vector<Ref<ComponentPool>> m_Pools;
+        std::vector<Ref<ComponentGroup>> m_Groups;
+        // Starts from 1, so that tick 0 means "before any change".
+        U32 m_ChangeTick{1};
     };
 
     inline bool ComponentManager::DoesPoolExist(U64 componentId) const
@@ -245,24 +1272,30 @@ namespace Engine
     }
 
     template <typename T, typename ... Args>
-    T& ComponentManager::Add(Entity entityId, Args&&... args)
+    ComponentRef<T> ComponentManager::Add(Entity entityId, Args&&... args)
     {
-        const U64 componentId = ComponentFamily::TYPE<T>;
-        if (componentId >= m_Pools.size())
-        {
-            // No pool for that component exists yet.
-            m_Pools.resize(componentId + 1);
-        }
-        if (!m_Pools[componentId])
+        ComponentPool& pool = GetOrCreatePool<T>();
+        ComponentRef<T> component = pool.Add<T>(entityId, std::forward<Args>(args)...);
+        pool.MarkChanged(pool.TryGetComponentIndex(entityId), m_ChangeTick);
+        if (pool.GetOwningGroup() == nullptr && pool.GetOnConstruct().IsEmpty()) return component;
+        if (ComponentGroup* group = pool.GetOwningGroup()) group->OnAdd(entityId);
+        pool.GetOnConstruct().Publish(entityId);
+        // Component might have been moved by group.
+        return pool.Get<T>(entityId);
+    }
+
+    template <typename T>
+    void ComponentManager::AddBatch(const std::vector<Entity>& entities, const T& prototype)
+    {
+        ComponentPool& pool = GetOrCreatePool<T>();
+        pool.AddBatch<T>(entities, prototype);
+        // Components of pointer-stable pool may be placed into the free slots, not just appended.
+        for (auto e : entities) pool.MarkChanged(pool.TryGetComponentIndex(e), m_ChangeTick);
+        if (ComponentGroup* group = pool.GetOwningGroup())
         {
-            // No pool for that component exists yet.
-            const Ref<ComponentPool> newPool = CreateRef<TComponentPool<T>>(sizeof(T));
-            newPool->SetDebugName(typeid(T).name());
-            m_Pools[componentId] = newPool;
+            for (auto e : entities) group->OnAdd(e);
         }
-
-        ComponentPool& pool = *m_Pools[componentId];
-        return pool.Add<T>(entityId, std::forward<Args>(args)...);
+        for (auto e : entities) pool.GetOnConstruct().Publish(e);
     }
 
     template <typename T>
@@ -271,9 +1304,30 @@ namespace Engine
         const U64 componentId = ComponentFamily::TYPE<T>;
         ENGINE_CORE_ASSERT(componentId < m_Pools.size(), "No pool for that component exists")
         ComponentPool& pool = *m_Pools[componentId];
+        pool.GetOnDestroy().Publish(entityId);
+        if (ComponentGroup* group = pool.GetOwningGroup()) group->OnRemove(entityId);
         pool.Pop<T>(entityId);
     }
 
+    inline void ComponentManager::RemoveBatch(U64 componentId, const std::vector<Entity>& entities)
+    {
+        if (!DoesPoolExist(componentId)) return;
+        ComponentPool& pool = *m_Pools[componentId];
+        if (!pool.GetOnDestroy().IsEmpty())
+        {
+            for (auto e : entities)
+            {
+                if (pool.Has(e)) pool.GetOnDestroy().Publish(e);
+            }
+        }
+        if (ComponentGroup* group = pool.GetOwningGroup())
+        {
+            // Move entities out of the group first, so that compaction keeps the group packed.
+            for (auto e : entities) group->OnRemove(e);
+        }
+        pool.PopBatch(entities);
+    }
+
     template <typename T>
     bool ComponentManager::Has(Entity entityId)
     {
@@ -284,18 +1338,20 @@ namespace Engine
     }
 
     template <typename T>
-    const T& ComponentManager::Get(Entity entityId) const
+    ConstComponentRef<T> ComponentManager::Get(Entity entityId) const
     {
         const U64 componentId = ComponentFamily::TYPE<T>;
         ENGINE_CORE_ASSERT(componentId < m_Pools.size(), "No pool for that component exists")
-        ComponentPool& pool = *m_Pools[componentId];
+        const ComponentPool& pool = *m_Pools[componentId];
         return pool.Get<T>(entityId);
     }
 
     template <typename T>
-    T& ComponentManager::Get(Entity entityId)
+    ComponentRef<T> ComponentManager::Get(Entity entityId)
     {
-        return const_cast<T&>(const_cast<ComponentManager*>(this)->Get<T>(entityId));
+        const U64 componentId = ComponentFamily::TYPE<T>;
+        ENGINE_CORE_ASSERT(componentId < m_Pools.size(), "No pool for that component exists")
+        return m_Pools[componentId]->Get<T>(entityId);
     }
 
     template <typename T>
@@ -304,5 +1360,40 @@ namespace Engine
         const U64 componentId = ComponentFamily::TYPE<T>;
         return GetComponentPool(componentId);
     }
+
+    template <typename ... Cmpts>
+    ComponentGroup& ComponentManager::GetOrCreateGroup()
+    {
+        static_assert(sizeof ...(Cmpts) > 1, "Group shall own at least 2 components");
+        std::vector<ComponentPool*> pools = {&GetOrCreatePool<Cmpts>()...};
+        if (ComponentGroup* group = pools.front()->GetOwningGroup())
+        {
+            ENGINE_CORE_ASSERT(group->GetPools().size() == pools.size() &&
+                std::ranges::all_of(pools, [group](auto* pool) { return pool->GetOwningGroup() == group; }),
+                "Component is already owned by another group")
+            return *group;
+        }
+        m_Groups.push_back(CreateRef<ComponentGroup>(pools));
+        return *m_Groups.back();
+    }
+
+    template <typename T>
+    ComponentPool& ComponentManager::GetOrCreatePool()
+    {
+        const U64 componentId = ComponentFamily::TYPE<T>;
+        if (componentId >= m_Pools.size())
+        {
+            // No pool for that component exists yet.
+            m_Pools.resize(componentId + 1);
+        }
+        if (!m_Pools[componentId])
+        {
+            // No pool for that component exists yet.
+            const Ref<ComponentPool> newPool = CreateRef<TComponentPool<T>>(sizeof(T));
+            newPool->SetDebugName(typeid(T).name());
+            m_Pools[componentId] = newPool;
+        }
+        return *m_Pools[componentId];
+    }
 }
 
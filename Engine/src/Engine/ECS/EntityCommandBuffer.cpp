@@ -0,0 +1,127 @@
+#include "enginepch.h"
+
+#include "EntityCommandBuffer.h"
+
+#include <cstdlib>
+
+namespace Engine
+{
+    EntityCommandBuffer::EntityCommandBuffer(Registry& registry)
+        : m_Registry(registry), m_ThreadBuffers(std::max(JobSystem::GetThreadCount(), 1u))
+    {
+    }
+
+    DeferredEntity EntityCommandBuffer::CreateEntity(const std::string& tag)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        buffer.Creations.push_back(tag);
+        return {JobSystem::GetThreadIndex(), static_cast<U32>(buffer.Creations.size() - 1)};
+    }
+
+    void EntityCommandBuffer::DeleteEntity(Entity entity)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        buffer.Deletions.push_back(entity);
+        buffer.Order.push_back(CommandType::Delete);
+    }
+
+    void EntityCommandBuffer::Playback()
+    {
+        // Creations go first, entities are referenced only by the commands recorded after their creation.
+        for (auto& buffer : m_ThreadBuffers)
+        {
+            buffer.Created.clear();
+            buffer.Created.reserve(buffer.Creations.size());
+            for (auto& tag : buffer.Creations) buffer.Created.push_back(m_Registry.CreateEntity(tag));
+            buffer.Creations.clear();
+        }
+        // Removals and deletions are batched until the next addition, which may depend on them (e.g. replacing a component).
+        std::vector<RemoveCommand> removals;
+        std::vector<Entity> deletions;
+        for (auto& buffer : m_ThreadBuffers)
+        {
+            U32 addIndex = 0, removeIndex = 0, deleteIndex = 0;
+            for (auto type : buffer.Order)
+            {
+                switch (type)
+                {
+                case CommandType::Add:
+                {
+                    PlaybackRemovals(removals, deletions);
+                    auto& command = buffer.Additions[addIndex++];
+                    Entity target = command.DeferredIndex == -1 ? command.Target : buffer.Created[command.DeferredIndex];
+                    if (m_Registry.IsEntityExists(target)) command.Add(m_Registry, target);
+                    break;
+                }
+                case CommandType::Remove:
+                    removals.push_back(buffer.Removals[removeIndex++]);
+                    break;
+                case CommandType::Delete:
+                    deletions.push_back(buffer.Deletions[deleteIndex++]);
+                    break;
+                }
+            }
+            buffer.Additions.clear();
+            buffer.Removals.clear();
+            buffer.Deletions.clear();
+            buffer.Order.clear();
+        }
+        PlaybackRemovals(removals, deletions);
+    }
+
+    void EntityCommandBuffer::PlaybackRemovals(std::vector<RemoveCommand>& removals, std::vector<Entity>& deletions)
+    {
+        // Grouped per component pool, the same removal may be recorded more than once (and shall publish `OnDestroy` once).
+        std::sort(removals.begin(), removals.end(), [](const RemoveCommand& a, const RemoveCommand& b)
+        {
+            return std::tie(a.ComponentId, a.Target.Id) < std::tie(b.ComponentId, b.Target.Id);
+        });
+        removals.erase(std::unique(removals.begin(), removals.end(), [](const RemoveCommand& a, const RemoveCommand& b)
+        {
+            return a.ComponentId == b.ComponentId && a.Target == b.Target;
+        }), removals.end());
+        std::vector<Entity> entities;
+        for (U32 i = 0; i < removals.size();)
+        {
+            U64 componentId = removals[i].ComponentId;
+            entities.clear();
+            for (; i < removals.size() && removals[i].ComponentId == componentId; i++)
+            {
+                if (m_Registry.IsEntityExists(removals[i].Target)) entities.push_back(removals[i].Target);
+            }
+            if (!entities.empty()) m_Registry.RemoveBatch(componentId, entities);
+        }
+        removals.clear();
+        if (!deletions.empty()) m_Registry.DeleteEntities(deletions);
+        deletions.clear();
+    }
+
+    Entity EntityCommandBuffer::Resolve(DeferredEntity deferred) const
+    {
+        const auto& created = m_ThreadBuffers[deferred.ThreadIndex].Created;
+        ENGINE_CORE_ASSERT(deferred.Index < created.size(), "Entity was not created by last playback")
+        return created[deferred.Index];
+    }
+
+    bool EntityCommandBuffer::IsEmpty() const
+    {
+        return std::ranges::all_of(m_ThreadBuffers, [](const ThreadBuffer& buffer)
+        {
+            return buffer.Creations.empty() && buffer.Additions.empty() &&
+                buffer.Removals.empty() && buffer.Deletions.empty();
+        });
+    }
+
+    EntityCommandBuffer::ThreadBuffer& EntityCommandBuffer::GetThreadBuffer()
+    {
+        U32 threadIndex = JobSystem::GetThreadIndex();
+        // Checked in every configuration, buffer created before `JobSystem::Init` has a single thread buffer.
+        if (threadIndex >= m_ThreadBuffers.size())
+        {
+            ENGINE_CORE_FATAL("Entity command buffer has no buffer for thread {}, it shall be created after JobSystem::Init",
+                threadIndex);
+            std::abort();
+        }
+        return m_ThreadBuffers[threadIndex];
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Registry.h"
+
+#include "Engine/Core/JobSystem.h"
+
+#include <functional>
+
+namespace Engine
+{
+    // Handle of an entity, that will be created on playback.
+    struct DeferredEntity
+    {
+        U32 ThreadIndex;
+        U32 Index;
+    };
+
+    // Records structural changes (creation / deletion of entities, addition / removal of components),
+    // so that they can be safely requested during iteration (including `View::ParallelEach`, each thread
+    // records into its own buffer) and applied later at a sync point by `Playback`.
+    // On playback entities are created first, other commands are applied in recorded order (thread after thread),
+    // runs of removals and deletions between additions are batched, so that each pool is compacted once per run.
+    // Commands targeting entities, that are dead at the moment of playback, are ignored.
+    // Buffer shall be created after `JobSystem::Init`, it has one buffer per job system thread.
+    class EntityCommandBuffer
+    {
+        enum class CommandType : U8
+        {
+            Add, Remove, Delete
+        };
+        struct AddCommand
+        {
+            Entity Target;
+            // Index of `DeferredEntity` if target is not created yet, -1 otherwise.
+            I32 DeferredIndex;
+            std::function<void(Registry&, Entity)> Add;
+        };
+        struct RemoveCommand
+        {
+            Entity Target;
+            U64 ComponentId;
+        };
+        struct ThreadBuffer
+        {
+            std::vector<std::string> Creations;
+            std::vector<AddCommand> Additions;
+            std::vector<RemoveCommand> Removals;
+            std::vector<Entity> Deletions;
+            // Types of additions, removals and deletions in recorded order.
+            std::vector<CommandType> Order;
+            std::vector<Entity> Created;
+        };
+    public:
+        EntityCommandBuffer(Registry& registry);
+
+        DeferredEntity CreateEntity(const std::string& tag = "Default");
+        void DeleteEntity(Entity entity);
+
+        template <typename T, typename ... Args>
+        void Add(Entity entity, Args&&... args);
+        template <typename T, typename ... Args>
+        void Add(DeferredEntity entity, Args&&... args);
+
+        // Removal of component, that entity does not have (at the moment of playback), is ignored.
+        template <typename T>
+        void Remove(Entity entity);
+
+        // Applies all recorded commands and clears the buffer, shall not be called during iteration.
+        void Playback();
+
+        // Returns the entity, created for `deferred` by the last `Playback`.
+        Entity Resolve(DeferredEntity deferred) const;
+
+        bool IsEmpty() const;
+    private:
+        ThreadBuffer& GetThreadBuffer();
+        // Applies (and clears) batched removals, then deletions.
+        void PlaybackRemovals(std::vector<RemoveCommand>& removals, std::vector<Entity>& deletions);
+        template <typename T>
+        static std::function<void(Registry&, Entity)> CreateAddFn(T&& component);
+    private:
+        Registry& m_Registry;
+        std::vector<ThreadBuffer> m_ThreadBuffers;
+    };
+
+    template <typename T, typename ... Args>
+    void EntityCommandBuffer::Add(Entity entity, Args&&... args)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        buffer.Additions.push_back({entity, -1, CreateAddFn(T(std::forward<Args>(args)...))});
+        buffer.Order.push_back(CommandType::Add);
+    }
+
+    template <typename T, typename ... Args>
+    void EntityCommandBuffer::Add(DeferredEntity entity, Args&&... args)
+    {
+        ENGINE_CORE_ASSERT(entity.ThreadIndex == JobSystem::GetThreadIndex(),
+            "Deferred entity belongs to the buffer of other thread")
+        ThreadBuffer& buffer = GetThreadBuffer();
+        buffer.Additions.push_back({NULL_ENTITY, static_cast<I32>(entity.Index), CreateAddFn(T(std::forward<Args>(args)...))});
+        buffer.Order.push_back(CommandType::Add);
+    }
+
+    template <typename T>
+    void EntityCommandBuffer::Remove(Entity entity)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        buffer.Removals.push_back({entity, ComponentFamily::TYPE<T>});
+        buffer.Order.push_back(CommandType::Remove);
+    }
+
+    template <typename T>
+    std::function<void(Registry&, Entity)> EntityCommandBuffer::CreateAddFn(T&& component)
+    {
+        return [component = std::forward<T>(component)](Registry& registry, Entity entity) mutable
+        {
+            registry.Add<std::decay_t<T>>(entity, std::move(component));
+        };
+    }
+}
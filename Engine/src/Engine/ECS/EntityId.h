@@ -40,6 +40,7 @@ namespace Engine
 	
 	struct EntityIdDecomposer
 	{
+		static constexpr U32 NULL_FLAG = NULL_ENTITY.Id;
 		static std::pair<U32, U32> Decompose(Entity id) { return std::make_pair(id.GetGeneration(), id.GetIndex()); }
 	};
 
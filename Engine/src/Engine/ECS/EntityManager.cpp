@@ -15,20 +15,63 @@ namespace Engine
         else
         {
             // Generate new entity.
-            newEntity = Entity(m_TotalEntities, 0);
+            newEntity = Entity(m_TotalEntities, m_FirstGeneration);
         }
         m_EntitiesSparseSet.Push(newEntity);
+        if (newEntity.GetIndex() >= m_Signatures.size()) m_Signatures.resize(newEntity.GetIndex() + 1);
+        m_Signatures[newEntity.GetIndex()].reset();
         m_TotalEntities++;
         return newEntity;
     }
 
+    std::vector<Entity> EntityManager::AddEntities(U32 count)
+    {
+        std::vector<Entity> entities;
+        entities.reserve(count);
+        m_EntitiesSparseSet.Reserve(m_TotalEntities + count);
+        U32 reused = std::min(count, static_cast<U32>(m_FreeEntities.size()));
+        entities.insert(entities.end(), m_FreeEntities.rbegin(), m_FreeEntities.rbegin() + reused);
+        m_FreeEntities.resize(m_FreeEntities.size() - reused);
+        // New entities continue after all existing indices (none of them are free at this point).
+        U32 firstNew = m_TotalEntities + reused;
+        for (U32 i = 0; i < count - reused; i++) entities.emplace_back(firstNew + i, m_FirstGeneration);
+        m_Signatures.resize(std::max(static_cast<U32>(m_Signatures.size()), firstNew + count - reused));
+        for (auto e : entities)
+        {
+            m_EntitiesSparseSet.Push(e);
+            m_Signatures[e.GetIndex()].reset();
+        }
+        m_TotalEntities += count;
+        return entities;
+    }
+
     void EntityManager::DeleteEntity(Entity entityId)
     {
         m_FreeEntities.push_back({entityId.GetIndex(), entityId.GetGeneration() + 1});
         m_EntitiesSparseSet.Pop(entityId);
+        m_Signatures[entityId.GetIndex()].reset();
         m_TotalEntities--;
     }
 
+    void EntityManager::ShrinkToFit()
+    {
+        // Once the free list is exhausted, new indices start from `m_TotalEntities`,
+        // which stays correct, as long as only the indices past every alive one are forgotten.
+        U32 indexCount = 0;
+        for (auto e : m_EntitiesSparseSet.GetDense()) indexCount = std::max(indexCount, e.GetIndex() + 1);
+        // Free entities hold the next generation of their index, new ones start from the highest of forgotten ones.
+        std::erase_if(m_FreeEntities, [this, indexCount](Entity e)
+        {
+            if (e.GetIndex() < indexCount) return false;
+            m_FirstGeneration = std::max(m_FirstGeneration, e.GetGeneration());
+            return true;
+        });
+        m_FreeEntities.shrink_to_fit();
+        m_Signatures.resize(indexCount);
+        m_Signatures.shrink_to_fit();
+        m_EntitiesSparseSet.ShrinkToFit();
+    }
+
     bool EntityManager::IsAlive(Entity entityId)
     {
         return m_EntitiesSparseSet.Has(entityId);
@@ -3,9 +3,16 @@
 #include "Engine/Common/SparseSetPaged.h"
 #include "Engine/ECS/EntityId.h"
 
+#include <bitset>
+
 namespace Engine
 {
 	using EntityContainer = SparseSetPaged<U32, Entity, EntityIdDecomposer>;
+
+	static constexpr U32 MAX_COMPONENTS = 128;
+	// Bit `i` is set if entity has component with id `i`.
+	using ComponentMask = std::bitset<MAX_COMPONENTS>;
+
 	class EntityManager
 	{
 		friend class Registry;
@@ -14,17 +21,32 @@ namespace Engine
 		EntityManager() = default;
 
 		Entity AddEntity(const std::string& tag = "Default");
+		// Creates `count` entities at once, reserving all the storage up front.
+		std::vector<Entity> AddEntities(U32 count);
 
 		void DeleteEntity(Entity entityId);
 
 		bool IsAlive(Entity entityId);
 
+		// Releases memory of deleted entities past the last alive one, when those indices are issued again,
+		// their generation is past every one they had, so that stale handles stay dead.
+		void ShrinkToFit();
+
 		U32 GetNullEntityFlag() const { return m_EntitiesSparseSet.GetNullFlag(); }
+
+		const ComponentMask& GetSignature(Entity entityId) const { return m_Signatures[entityId.GetIndex()]; }
 		
+	private:
+		void AddToSignature(Entity entityId, U64 componentId) { m_Signatures[entityId.GetIndex()].set(componentId); }
+		void RemoveFromSignature(Entity entityId, U64 componentId) { m_Signatures[entityId.GetIndex()].reset(componentId); }
 	private:
 		EntityContainer m_EntitiesSparseSet;
 		EntityVector m_FreeEntities{};
+		// Indexed by entity index.
+		std::vector<ComponentMask> m_Signatures{};
 
 		U32 m_TotalEntities = 0;
+		// Generation of indices, that are issued for the first time (or again after `ShrinkToFit`).
+		U32 m_FirstGeneration = 0;
 	};
 }
\ No newline at end of file
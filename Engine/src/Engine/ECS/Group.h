@@ -0,0 +1,71 @@
+#pragma once
+#include "ComponentsManager.h"
+#include "EntityId.h"
+#include "Engine/Core/Types.h"
+
+namespace Engine
+{
+    using namespace Types;
+
+    // Cmpts for components.
+    // Lightweight handle to the `ComponentGroup`, created by `Registry::Group<Cmpts...>()`.
+    template <typename ... Cmpts>
+    class OwningGroup
+    {
+        static_assert((!SoaComponent<Cmpts> && ...), "Structure-of-arrays component cannot be owned by group");
+    public:
+        OwningGroup(const ComponentGroup& group, const std::array<ComponentPool*, sizeof ...(Cmpts)>& pools)
+            : m_Group(group), m_Pools(pools)
+        {
+        }
+
+        U32 GetSize() const { return m_Group.GetSize(); }
+
+        // Calls `fn(entity, components&...)` (or `fn(components&...)`) for every entity of the group.
+        // All pools are walked in lockstep page by page, no lookups or membership checks are done.
+        // Goes from the back, so it is safe to delete the current entity inside `fn`.
+        template <typename Fn>
+        void Each(Fn fn) const
+        {
+            EachImpl(fn, std::index_sequence_for<Cmpts...>{});
+        }
+
+    private:
+        template <typename Fn, U64 ... Indices>
+        void EachImpl(Fn& fn, std::index_sequence<Indices...>) const
+        {
+            const auto& entities = m_Pools.front()->GetDenseEntities();
+            I32 size = static_cast<I32>(m_Group.GetSize());
+            for (I32 pageBegin = (size - 1) & ~static_cast<I32>(SPARSE_SET_PAGE_SIZE - 1); pageBegin >= 0; pageBegin -= SPARSE_SET_PAGE_SIZE)
+            {
+                std::tuple<Cmpts*...> pages = {&m_Pools[Indices]->template GetComponent<Cmpts>(pageBegin)...};
+                I32 pageEnd = std::min(size, pageBegin + static_cast<I32>(SPARSE_SET_PAGE_SIZE));
+                for (I32 i = pageEnd - 1; i >= pageBegin; i--)
+                {
+                    // Callback is allowed to delete entities, so the group may shrink by more than one.
+                    if (i >= static_cast<I32>(m_Group.GetSize())) continue;
+                    if constexpr (std::is_invocable_v<Fn&, Entity, Cmpts&...>)
+                    {
+                        fn(entities[i], GetFromPage(std::get<Indices>(pages), i - pageBegin)...);
+                    }
+                    else
+                    {
+                        fn(GetFromPage(std::get<Indices>(pages), i - pageBegin)...);
+                    }
+                }
+            }
+        }
+
+        template <typename T>
+        static T& GetFromPage(T* page, I32 offset)
+        {
+            // Empty components have no pages, `page` points to the shared instance.
+            if constexpr (std::is_empty_v<T>) return *page;
+            else return page[offset];
+        }
+
+    private:
+        const ComponentGroup& m_Group;
+        std::array<ComponentPool*, sizeof ...(Cmpts)> m_Pools;
+    };
+}
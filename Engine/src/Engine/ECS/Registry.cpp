@@ -15,12 +15,21 @@ namespace Engine
         {
             DeleteEntity(e);
         }
+        // Every index is issued again from the start, past the generations it has had.
+        for (auto e : m_EntityManager.m_FreeEntities)
+        {
+            m_EntityManager.m_FirstGeneration = std::max(m_EntityManager.m_FirstGeneration, e.GetGeneration());
+        }
         m_EntityManager.m_FreeEntities.clear();
+        // Signatures are kept for every index ever used (since the last shrink), so it is the high-water mark.
+        if (m_ShrinkHighWaterMark != 0 && m_EntityManager.m_Signatures.size() > m_ShrinkHighWaterMark) ShrinkToFit();
     }
 
     Entity Registry::CreateEntity(const std::string& tag)
     {
+        AssertNoStructuralLock();
         Entity entityId = m_EntityManager.AddEntity(tag);
+        m_EntityManager.AddToSignature(entityId, ComponentFamily::TYPE<Component::Name>);
         m_ComponentManager.Add<Component::Name>(entityId, tag);
         return entityId;
     }
@@ -33,12 +42,131 @@ namespace Engine
 
     void Registry::DeleteEntity(Entity entityId)
     {
+        AssertNoStructuralLock();
+        // Entity is released last, so that `OnDestroy` callbacks see it alive.
+        for (auto& componentPool : m_ComponentManager.m_Pools)
+        {
+            if (componentPool && componentPool->Has(entityId))
+            {
+                componentPool->GetOnDestroy().Publish(entityId);
+                if (ComponentGroup* group = componentPool->GetOwningGroup()) group->OnRemove(entityId);
+                componentPool->Pop(entityId);
+            }
+        }
         m_EntityManager.DeleteEntity(entityId);
+    }
+
+    void Registry::Compact()
+    {
+        AssertNoStructuralLock();
+        for (auto& pool : m_ComponentManager.m_Pools)
+        {
+            if (pool && pool->GetTombstoneCount() > 0) pool->Compact();
+        }
+    }
+
+    void Registry::ShrinkToFit()
+    {
+        AssertNoStructuralLock();
+        Compact();
+        for (auto& pool : m_ComponentManager.m_Pools)
+        {
+            if (pool) pool->ShrinkToFit();
+        }
+        m_EntityManager.ShrinkToFit();
+    }
+
+    void Registry::RemoveBatch(U64 componentId, const std::vector<Entity>& entities)
+    {
+        AssertNoStructuralLock();
+        m_ComponentManager.RemoveBatch(componentId, entities);
+        for (auto e : entities)
+        {
+            if (m_EntityManager.IsAlive(e)) m_EntityManager.RemoveFromSignature(e, componentId);
+        }
+    }
+
+    void Registry::DeleteEntities(std::span<const Entity> toDelete)
+    {
+        AssertNoStructuralLock();
+        std::vector<Entity> entities(toDelete.begin(), toDelete.end());
+        std::sort(entities.begin(), entities.end(), [](Entity a, Entity b) { return a.Id < b.Id; });
+        entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+        std::erase_if(entities, [this](Entity e) { return !m_EntityManager.IsAlive(e); });
         
-        for (auto& componentPool : m_ComponentManager.m_Pools)
+        for (U64 componentId = 0; componentId < m_ComponentManager.GetPoolCount(); componentId++)
+        {
+            m_ComponentManager.RemoveBatch(componentId, entities);
+        }
+        // Entities are released last, so that `OnDestroy` callbacks see them alive.
+        for (auto e : entities) m_EntityManager.DeleteEntity(e);
+    }
+
+    RegistrySnapshot Registry::Snapshot() const
+    {
+        return SnapshotImpl(nullptr);
+    }
+
+    RegistrySnapshot Registry::Snapshot(const RegistrySnapshot& base) const
+    {
+        return SnapshotImpl(&base);
+    }
+
+    void Registry::Restore(const RegistrySnapshot& snapshot)
+    {
+        AssertNoStructuralLock();
+        ENGINE_CORE_ASSERT(snapshot.m_GroupSizes.size() == m_ComponentManager.m_Groups.size(),
+            "Groups were created after the snapshot")
+        auto& entities = m_EntityManager.m_EntitiesSparseSet;
+        entities.Clear();
+        entities.Reserve(static_cast<U32>(snapshot.m_Entities.size()));
+        for (auto e : snapshot.m_Entities) entities.Push(e);
+        m_EntityManager.m_FreeEntities = snapshot.m_FreeEntities;
+        m_EntityManager.m_Signatures = snapshot.m_Signatures;
+        m_EntityManager.m_TotalEntities = snapshot.m_TotalEntities;
+        m_EntityManager.m_FirstGeneration = snapshot.m_FirstGeneration;
+
+        // Pools may only be added after the snapshot, these are just cleared.
+        U32 tick = GetChangeTick();
+        for (U64 componentId = 0; componentId < m_ComponentManager.GetPoolCount(); componentId++)
+        {
+            auto& pool = m_ComponentManager.m_Pools[componentId];
+            if (!pool) continue;
+            if (componentId < snapshot.m_Pools.size() && snapshot.m_Pools[componentId].IsValid)
+            {
+                pool->RestoreSnapshot(snapshot.m_Pools[componentId], tick);
+            }
+            else
+            {
+                pool->Clear();
+            }
+        }
+        for (U32 i = 0; i < snapshot.m_GroupSizes.size(); i++)
+        {
+            m_ComponentManager.m_Groups[i]->m_Size = snapshot.m_GroupSizes[i];
+        }
+    }
+
+    RegistrySnapshot Registry::SnapshotImpl(const RegistrySnapshot* base) const
+    {
+        RegistrySnapshot snapshot;
+        snapshot.m_Entities = m_EntityManager.m_EntitiesSparseSet.GetDense();
+        snapshot.m_FreeEntities = m_EntityManager.m_FreeEntities;
+        snapshot.m_Signatures = m_EntityManager.m_Signatures;
+        snapshot.m_TotalEntities = m_EntityManager.m_TotalEntities;
+        snapshot.m_FirstGeneration = m_EntityManager.m_FirstGeneration;
+
+        snapshot.m_Pools.resize(m_ComponentManager.GetPoolCount());
+        for (U64 componentId = 0; componentId < m_ComponentManager.GetPoolCount(); componentId++)
         {
-            if (componentPool && componentPool->Has(entityId)) componentPool->Pop(entityId);
+            auto& pool = m_ComponentManager.m_Pools[componentId];
+            if (!pool) continue;
+            const ComponentPoolSnapshot* basePool = base != nullptr && componentId < base->m_Pools.size() &&
+                base->m_Pools[componentId].IsValid ? &base->m_Pools[componentId] : nullptr;
+            pool->SaveSnapshot(snapshot.m_Pools[componentId], basePool);
         }
+        for (auto& group : m_ComponentManager.m_Groups) snapshot.m_GroupSizes.push_back(group->GetSize());
+        return snapshot;
     }
 
     bool Registry::IsComponentExists(U64 componentId) const
@@ -2,22 +2,31 @@
 #include "ComponentsManager.h"
 #include "EntityId.h"
 #include "EntityManager.h"
+#include "Group.h"
+#include "RegistrySnapshot.h"
 
 namespace Engine
 {
     class Registry
     {
+        friend class EntityCommandBuffer;
     public:
         ~Registry();
         void Clear();
         Entity CreateEntity(const std::string& tag = "Default");
         Entity GetEntity(Entity entity) const;
         void DeleteEntity(Entity entity);
+        // Creates `count` entities, each one gets a copy of every prototype component.
+        // Storage of every pool is reserved once and components are constructed in a tight loop.
+        template <typename ... Cmpts>
+        std::vector<Entity> CreateEntities(U32 count, const std::string& tag, const Cmpts&... prototypes);
+        // Deletes all `entities` (dead ones and duplicates are ignored), each pool is compacted once.
+        void DeleteEntities(std::span<const Entity> entities);
         U32 TotalEntities() const { return m_EntityManager.m_TotalEntities; }
 
         // Add specified component to entity.
         template <typename T, typename ... Args>
-        T& Add(Entity entity, Args&&... args);
+        ComponentRef<T> Add(Entity entity, Args&&... args);
 
         // Remove specified component from entity.
         template <typename T>
@@ -32,37 +41,142 @@ namespace Engine
         bool IsComponentExists(U64 componentId) const;
         bool IsEntityExists(Entity entity) const;
 
-        // Returns the entities component.
+        // Returns the entities component (`SoaRef<T>` proxy for structure-of-arrays components, see `SoaLayout`).
         template<typename T>
-        const T& Get(Entity entity) const;
+        ConstComponentRef<T> Get(Entity entity) const;
         template<typename T>
-        T& Get(Entity entity);
+        ComponentRef<T> Get(Entity entity);
 
         template<typename T>
-        T& AddOrGet(Entity entity);
+        ComponentRef<T> AddOrGet(Entity entity);
+
+        // Calls `fn(component)` and marks the component changed (see `MarkChanged`).
+        template <typename T, typename Fn>
+        ComponentRef<T> Patch(Entity entity, Fn fn);
+
+        // Raw array of `Member` field of page `pageIndex` of structure-of-arrays pool (see `SoaLayout`),
+        // for SIMD processing of several components at once. Elements follow `GetComponentPool<T>().GetDenseEntities()`.
+        // Writes through the span are not change-tracked, use `MarkChanged` if needed.
+        template <auto Member>
+        std::span<typename MemberTraits<decltype(Member)>::FieldType> GetFieldSpan(U32 pageIndex);
+
+        // Sorts `T` pool in place (insertion sort, cheap if pool is nearly sorted),
+        // `compare` takes either two components or two entities.
+        template <typename T, typename Compare>
+        void Sort(Compare compare);
+        // Reorders `T` pool, so that entities that also have `U` go in the same order as in `U` pool.
+        template <typename T, typename U>
+        void SortAs();
+        // Same as `std::rotate` on [first, last) of `T` pool's dense array.
+        template <typename T>
+        void Rotate(U32 first, U32 middle, U32 last);
+        // Moves components of `entities` to the front of `T` pool in the same order.
+        template <typename T>
+        void Arrange(std::span<const Entity> entities);
+
+        // Removes tombstones of pointer-stable `T` pool (see `ComponentTraits`), pointers to its components are invalidated.
+        template <typename T>
+        void Compact();
+        // Removes tombstones of every pool.
+        void Compact();
+        // Compacts, then releases pool pages past the last component, sparse pages, that are not used anymore,
+        // and unused capacity. Indices of deleted entities past the last alive one are forgotten, and issued again
+        // with a generation past every one they had, so handles to deleted entities stay dead.
+        void ShrinkToFit();
+        // If not 0, `Clear` (scene transition) calls `ShrinkToFit`, when registry has had
+        // more than `entityCount` entities at once since the last shrink.
+        void SetShrinkHighWaterMark(U32 entityCount) { m_ShrinkHighWaterMark = entityCount; }
+
+        // Observers: `OnConstruct` callbacks are called after `T` was added to entity, `OnDestroy` ones
+        // before it is removed (also on entity deletion), `OnUpdate` ones by `MarkChanged<T>`.
+        // `Restore` does not call them. Callbacks may not remove `T` from the entity they are called for.
+        template <typename T>
+        ComponentSink& OnConstruct();
+        template <typename T>
+        ComponentSink& OnDestroy();
+        template <typename T>
+        ComponentSink& OnUpdate();
+
+        // Change tracking: `Add`, `Patch` and `MarkChanged` stamp the component with current change tick,
+        // writes through `Get` and views are not tracked. A system keeps the tick returned by `AdvanceChangeTick` when it runs, and passes it
+        // to `View::Changed` on its next run, to visit only the components changed since then.
+        template <typename T>
+        void MarkChanged(Entity entity);
+        U32 GetChangeTick() const { return m_ComponentManager.GetChangeTick(); }
+        // Returns current tick and starts a new one.
+        U32 AdvanceChangeTick() { return m_ComponentManager.m_ChangeTick++; }
+
+        // Copies all entities and components (trivially copyable components with raw memcpy,
+        // others with `ComponentSnapshotTraits<T>::Copy`).
+        RegistrySnapshot Snapshot() const;
+        // Delta snapshot: component pages that are equal to the pages of `base` are shared with it, not copied.
+        RegistrySnapshot Snapshot(const RegistrySnapshot& base) const;
+        // Brings registry back to the state of `snapshot`, restored components are marked as changed.
+        // Groups shall not be created after the snapshot was made.
+        void Restore(const RegistrySnapshot& snapshot);
+
+        // Returns owning group of specified components (creates it on first call),
+        // each component can be owned by one group only.
+        template <typename ... Cmpts>
+        OwningGroup<Cmpts...> Group();
         
         template <typename T>
         const ComponentPool& GetComponentPool() const;
         const ComponentPool& GetComponentPool(U64 componentId) const;
 
         const EntityManager& GetEntityManager() const { return m_EntityManager; }
+
+        // While locked, structural changes (creation / deletion of entities and components)
+        // are forbidden (checked in debug builds only), used by parallel iteration.
+        void LockStructuralChanges() const;
+        void UnlockStructuralChanges() const;
         
+    private:
+        void AssertNoStructuralLock() const;
+        // Batched version of `Remove`, pool is compacted once.
+        void RemoveBatch(U64 componentId, const std::vector<Entity>& entities);
+        RegistrySnapshot SnapshotImpl(const RegistrySnapshot* base) const;
     private:
         ComponentManager m_ComponentManager{};
         EntityManager m_EntityManager{};
+        U32 m_ShrinkHighWaterMark{0};
+#ifdef ENGINE_DEBUG
+        // Atomic, since parallel sections may be nested (e.g. `ParallelEach` inside of `SystemGraph` stage).
+        mutable std::atomic<U32> m_StructuralLocks{0};
+#endif
     };
 
     template <typename T, typename ... Args>
-    T& Registry::Add(Entity entity, Args&&... args)
+    ComponentRef<T> Registry::Add(Entity entity, Args&&... args)
     {
         ENGINE_CORE_ASSERT(m_EntityManager.IsAlive(entity), "Entity no longer exists, or haven't existed at all.")
+        AssertNoStructuralLock();
+        m_EntityManager.AddToSignature(entity, ComponentFamily::TYPE<T>);
         return m_ComponentManager.Add<T, Args...>(entity, std::forward<Args>(args)...);
     }
 
+    template <typename ... Cmpts>
+    std::vector<Entity> Registry::CreateEntities(U32 count, const std::string& tag, const Cmpts&... prototypes)
+    {
+        AssertNoStructuralLock();
+        std::vector<Entity> entities = m_EntityManager.AddEntities(count);
+        // Signatures go first (as in `Add`), so that `OnConstruct` observers see all components of new entities.
+        for (auto e : entities)
+        {
+            m_EntityManager.AddToSignature(e, ComponentFamily::TYPE<Component::Name>);
+            (m_EntityManager.AddToSignature(e, ComponentFamily::TYPE<Cmpts>), ...);
+        }
+        m_ComponentManager.AddBatch<Component::Name>(entities, Component::Name{tag});
+        (m_ComponentManager.AddBatch<Cmpts>(entities, prototypes), ...);
+        return entities;
+    }
+
     template <typename T>
     void Registry::Remove(Entity entity)
     {
+        AssertNoStructuralLock();
         m_ComponentManager.Remove<T>(entity);
+        m_EntityManager.RemoveFromSignature(entity, ComponentFamily::TYPE<T>);
     }
 
     template <typename T>
@@ -73,24 +187,146 @@ namespace Engine
     }
 
     template <typename T>
-    const T& Registry::Get(Entity entity) const
+    ConstComponentRef<T> Registry::Get(Entity entity) const
+    {
+        return m_ComponentManager.GetComponentPool<T>().template Get<T>(entity);
+    }
+
+    template <typename T>
+    ComponentRef<T> Registry::Get(Entity entity)
+    {
+        auto& pool = const_cast<ComponentPool&>(m_ComponentManager.GetComponentPool<T>());
+        U32 componentIndex = pool.TryGetComponentIndex(entity);
+        ENGINE_CORE_ASSERT(componentIndex != pool.GetNullIndex(), "Entity has no such component")
+        return pool.template GetComponent<T>(componentIndex);
+    }
+
+    template <typename T, typename Fn>
+    ComponentRef<T> Registry::Patch(Entity entity, Fn fn)
+    {
+        ComponentRef<T> component = Get<T>(entity);
+        fn(component);
+        MarkChanged<T>(entity);
+        return component;
+    }
+
+    template <auto Member>
+    std::span<typename MemberTraits<decltype(Member)>::FieldType> Registry::GetFieldSpan(U32 pageIndex)
+    {
+        using T = typename MemberTraits<decltype(Member)>::ClassType;
+        auto& pool = const_cast<ComponentPool&>(m_ComponentManager.GetComponentPool<T>());
+        return pool.GetFieldSpan<Member>(pageIndex);
+    }
+
+    template <typename T, typename Compare>
+    void Registry::Sort(Compare compare)
+    {
+        AssertNoStructuralLock();
+        if (!IsComponentExists(ComponentFamily::TYPE<T>)) return;
+        auto& pool = const_cast<ComponentPool&>(m_ComponentManager.GetComponentPool<T>());
+        pool.Sort<T>(compare);
+    }
+
+    template <typename T, typename U>
+    void Registry::SortAs()
+    {
+        AssertNoStructuralLock();
+        if (!IsComponentExists(ComponentFamily::TYPE<T>) || !IsComponentExists(ComponentFamily::TYPE<U>)) return;
+        auto& pool = const_cast<ComponentPool&>(m_ComponentManager.GetComponentPool<T>());
+        pool.SortAs<T>(m_ComponentManager.GetComponentPool<U>());
+    }
+
+    template <typename T>
+    void Registry::Rotate(U32 first, U32 middle, U32 last)
+    {
+        AssertNoStructuralLock();
+        auto& pool = const_cast<ComponentPool&>(m_ComponentManager.GetComponentPool<T>());
+        pool.Rotate<T>(first, middle, last);
+    }
+
+    template <typename T>
+    void Registry::Arrange(std::span<const Entity> entities)
+    {
+        AssertNoStructuralLock();
+        if (entities.empty()) return;
+        auto& pool = const_cast<ComponentPool&>(m_ComponentManager.GetComponentPool<T>());
+        pool.Arrange<T>(entities);
+    }
+
+    template <typename T>
+    void Registry::Compact()
+    {
+        AssertNoStructuralLock();
+        if (!IsComponentExists(ComponentFamily::TYPE<T>)) return;
+        auto& pool = const_cast<ComponentPool&>(m_ComponentManager.GetComponentPool<T>());
+        pool.Compact<T>();
+    }
+
+    template <typename T>
+    void Registry::MarkChanged(Entity entity)
+    {
+        auto& pool = const_cast<ComponentPool&>(m_ComponentManager.GetComponentPool<T>());
+        U32 componentIndex = pool.TryGetComponentIndex(entity);
+        ENGINE_CORE_ASSERT(componentIndex != pool.GetNullIndex(), "Entity has no such component")
+        pool.MarkChanged(componentIndex, GetChangeTick());
+        pool.GetOnUpdate().Publish(entity);
+    }
+
+    template <typename T>
+    ComponentSink& Registry::OnConstruct()
     {
-        return m_ComponentManager.GetComponentPool<T>().Get<T>(entity);
+        return m_ComponentManager.GetOrCreatePool<T>().GetOnConstruct();
     }
 
     template <typename T>
-    T& Registry::Get(Entity entity)
+    ComponentSink& Registry::OnDestroy()
     {
-        return const_cast<T&>(const_cast<const Registry*>(this)->Get<T>(entity));
+        return m_ComponentManager.GetOrCreatePool<T>().GetOnDestroy();
     }
 
     template <typename T>
-    T& Registry::AddOrGet(Entity entity)
+    ComponentSink& Registry::OnUpdate()
+    {
+        return m_ComponentManager.GetOrCreatePool<T>().GetOnUpdate();
+    }
+
+    template <typename T>
+    ComponentRef<T> Registry::AddOrGet(Entity entity)
     {
         if (Has<T>(entity)) return Get<T>(entity);
         return Add<T>(entity);
     }
 
+    template <typename ... Cmpts>
+    OwningGroup<Cmpts...> Registry::Group()
+    {
+        AssertNoStructuralLock();
+        ComponentGroup& group = m_ComponentManager.GetOrCreateGroup<Cmpts...>();
+        return OwningGroup<Cmpts...>(group, {{&m_ComponentManager.GetOrCreatePool<Cmpts>()...}});
+    }
+
+    inline void Registry::LockStructuralChanges() const
+    {
+#ifdef ENGINE_DEBUG
+        m_StructuralLocks++;
+#endif
+    }
+
+    inline void Registry::UnlockStructuralChanges() const
+    {
+#ifdef ENGINE_DEBUG
+        ENGINE_CORE_ASSERT(m_StructuralLocks > 0, "Registry is not locked")
+        m_StructuralLocks--;
+#endif
+    }
+
+    inline void Registry::AssertNoStructuralLock() const
+    {
+#ifdef ENGINE_DEBUG
+        ENGINE_CORE_ASSERT(m_StructuralLocks == 0, "Structural change of registry during parallel section")
+#endif
+    }
+
     inline bool Registry::Has(U64 componentId, Entity entity) const
     {
         if (!m_ComponentManager.DoesPoolExist(componentId)) return false;
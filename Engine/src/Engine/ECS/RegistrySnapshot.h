@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ComponentsManager.h"
+#include "EntityManager.h"
+
+namespace Engine
+{
+    // Copy of all entities and components of registry, made by `Registry::Snapshot`
+    // and applied by `Registry::Restore` (e.g. for rollback or quick save states).
+    // Component pages are immutable once captured, so delta snapshots share unchanged pages with their base.
+    class RegistrySnapshot
+    {
+        friend class Registry;
+    public:
+        U32 GetEntityCount() const { return static_cast<U32>(m_Entities.size()); }
+    private:
+        std::vector<Entity> m_Entities;
+        std::vector<Entity> m_FreeEntities;
+        std::vector<ComponentMask> m_Signatures;
+        U32 m_TotalEntities{0};
+        U32 m_FirstGeneration{0};
+        // Indexed by component id.
+        std::vector<ComponentPoolSnapshot> m_Pools;
+        std::vector<U32> m_GroupSizes;
+    };
+}
@@ -0,0 +1,91 @@
+#include "enginepch.h"
+
+#include "SystemGraph.h"
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/Time.h"
+
+namespace Engine
+{
+    SystemGraph::SystemGraph(Registry& registry)
+        : m_Registry(registry), m_CommandBuffer(registry)
+    {
+    }
+
+    SystemGraph::SystemDesc SystemGraph::AddSystem(const std::string& name, SystemFn fn)
+    {
+        m_Systems.push_back({.Name = name, .Fn = std::move(fn)});
+        m_IsDirty = true;
+        return SystemDesc(*this, static_cast<U32>(m_Systems.size() - 1));
+    }
+
+    void SystemGraph::Run(F32 dt)
+    {
+        if (m_IsDirty) Build();
+        for (auto& stage : m_Stages)
+        {
+            if (m_Systems[stage.front()].IsExclusive)
+            {
+                RunSystem(stage.front(), dt);
+            }
+            else
+            {
+                m_Registry.LockStructuralChanges();
+                JobCounter counter;
+                for (U32 i = 1; i < stage.size(); i++)
+                {
+                    JobSystem::Submit([this, systemIndex = stage[i], dt]() { RunSystem(systemIndex, dt); }, &counter);
+                }
+                // The first system is run by the calling thread.
+                RunSystem(stage.front(), dt);
+                JobSystem::Wait(counter);
+                m_Registry.UnlockStructuralChanges();
+            }
+            if (!m_CommandBuffer.IsEmpty()) m_CommandBuffer.Playback();
+        }
+    }
+
+    std::vector<SystemGraph::SystemTiming> SystemGraph::GetTimings() const
+    {
+        std::vector<SystemTiming> timings;
+        timings.reserve(m_Systems.size());
+        for (auto& system : m_Systems) timings.push_back({system.Name, system.LastTimeMs, system.AverageTimeMs});
+        return timings;
+    }
+
+    void SystemGraph::Build()
+    {
+        // Stage of system is one past the latest stage of earlier systems it conflicts with
+        // (that is the length of the longest dependency path to it),
+        // exclusive system conflicts with every other, so it always gets a stage of its own.
+        std::vector<U32> systemStages(m_Systems.size(), 0);
+        U32 stageCount = 0;
+        for (U32 i = 0; i < m_Systems.size(); i++)
+        {
+            for (U32 j = 0; j < i; j++)
+            {
+                if (IsConflicting(m_Systems[i], m_Systems[j])) systemStages[i] = std::max(systemStages[i], systemStages[j] + 1);
+            }
+            stageCount = std::max(stageCount, systemStages[i] + 1);
+        }
+        m_Stages.assign(stageCount, {});
+        for (U32 i = 0; i < m_Systems.size(); i++) m_Stages[systemStages[i]].push_back(i);
+        m_IsDirty = false;
+    }
+
+    void SystemGraph::RunSystem(U32 systemIndex, F32 dt)
+    {
+        System& system = m_Systems[systemIndex];
+        Timer timer;
+        system.Fn(dt);
+        system.LastTimeMs = timer.GetTime();
+        system.AverageTimeMs = system.AverageTimeMs == 0.0 ?
+            system.LastTimeMs : system.AverageTimeMs * 0.95 + system.LastTimeMs * 0.05;
+    }
+
+    bool SystemGraph::IsConflicting(const System& a, const System& b)
+    {
+        if (a.IsExclusive || b.IsExclusive) return true;
+        return (a.Writes & (b.Reads | b.Writes)).any() || (b.Writes & a.Reads).any();
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "EntityCommandBuffer.h"
+#include "EntityManager.h"
+#include "Registry.h"
+
+#include "Engine/Core/Types.h"
+
+#include <functional>
+
+namespace Engine
+{
+    using namespace Types;
+
+    // Runs systems, that declare which components they read and write.
+    // Each system depends on every earlier added system it conflicts with
+    // (one writes what the other reads or writes), systems are then levelled into stages
+    // by the longest dependency path, and systems of the same stage run concurrently on the job system.
+    // Systems of concurrent stages shall use only the declared components and shall not make structural
+    // changes directly (use `GetCommandBuffer`, it is played back after every stage).
+    // Systems that make structural changes, or touch non-component shared state (input, physics world, etc.),
+    // shall be marked `Exclusive`: they run alone on the calling thread.
+    class SystemGraph
+    {
+    public:
+        using SystemFn = std::function<void(F32 dt)>;
+
+        struct SystemTiming
+        {
+            std::string_view Name;
+            F64 LastTimeMs;
+            // Exponential moving average.
+            F64 AverageTimeMs;
+        };
+
+        // Returned by `AddSystem` to declare system's access.
+        class SystemDesc
+        {
+            friend class SystemGraph;
+        public:
+            template <typename ... Cmpts>
+            SystemDesc& Reads();
+            template <typename ... Cmpts>
+            SystemDesc& Writes();
+            SystemDesc& Exclusive();
+        private:
+            SystemDesc(SystemGraph& graph, U32 systemIndex) : m_Graph(graph), m_SystemIndex(systemIndex) {}
+        private:
+            SystemGraph& m_Graph;
+            U32 m_SystemIndex;
+        };
+    public:
+        SystemGraph(Registry& registry);
+
+        SystemDesc AddSystem(const std::string& name, SystemFn fn);
+
+        // Runs all systems, respecting the order they were added in for conflicting ones.
+        void Run(F32 dt);
+
+        EntityCommandBuffer& GetCommandBuffer() { return m_CommandBuffer; }
+
+        // Timings of systems in the order they were added in.
+        std::vector<SystemTiming> GetTimings() const;
+    private:
+        struct System
+        {
+            std::string Name;
+            SystemFn Fn;
+            ComponentMask Reads{};
+            ComponentMask Writes{};
+            bool IsExclusive{false};
+            F64 LastTimeMs{0.0};
+            F64 AverageTimeMs{0.0};
+        };
+        void Build();
+        void RunSystem(U32 systemIndex, F32 dt);
+        static bool IsConflicting(const System& a, const System& b);
+    private:
+        Registry& m_Registry;
+        EntityCommandBuffer m_CommandBuffer;
+        std::vector<System> m_Systems;
+        // Indices of systems, that can run concurrently.
+        std::vector<std::vector<U32>> m_Stages;
+        bool m_IsDirty{false};
+    };
+
+    template <typename ... Cmpts>
+    SystemGraph::SystemDesc& SystemGraph::SystemDesc::Reads()
+    {
+        (m_Graph.m_Systems[m_SystemIndex].Reads.set(ComponentFamily::TYPE<Cmpts>), ...);
+        m_Graph.m_IsDirty = true;
+        return *this;
+    }
+
+    template <typename ... Cmpts>
+    SystemGraph::SystemDesc& SystemGraph::SystemDesc::Writes()
+    {
+        (m_Graph.m_Systems[m_SystemIndex].Writes.set(ComponentFamily::TYPE<Cmpts>), ...);
+        m_Graph.m_IsDirty = true;
+        return *this;
+    }
+
+    inline SystemGraph::SystemDesc& SystemGraph::SystemDesc::Exclusive()
+    {
+        m_Graph.m_Systems[m_SystemIndex].IsExclusive = true;
+        m_Graph.m_IsDirty = true;
+        return *this;
+    }
+}
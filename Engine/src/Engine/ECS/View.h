@@ -1,20 +1,54 @@
 ﻿#pragma once
 #include "EntityId.h"
 #include "Registry.h"
+#include "Engine/Core/JobSystem.h"
 #include "Engine/Core/Types.h"
 
 namespace Engine
 {
     using namespace Types;
     
-    // Cmpts for components.
-    template <typename ... Cmpts>
-    class View
+    // List of components, entities having any of them are skipped by view.
+    template <typename ... Ex>
+    struct ExcludeList {};
+
+    // Component, that entity may not have, `Each` passes it as pointer (nullptr if absent).
+    template <typename T>
+    struct Optional {};
+
+    template <typename T>
+    struct ViewComponentTraits
+    {
+        using Type = T;
+        // Structure-of-arrays components are passed by `SoaRef<T>` proxy.
+        using Accessor = ComponentRef<T>;
+        static constexpr bool IS_OPTIONAL = false;
+    };
+
+    template <typename T>
+    struct ViewComponentTraits<Optional<T>>
+    {
+        static_assert(!SoaComponent<T>, "Structure-of-arrays component cannot be optional");
+        using Type = T;
+        using Accessor = T*;
+        static constexpr bool IS_OPTIONAL = true;
+    };
+
+    template <typename Excluded, typename ... Cmpts>
+    class BasicView;
+
+    // Cmpts for components, Ex for excluded components.
+    template <typename ... Ex, typename ... Cmpts>
+    class BasicView<ExcludeList<Ex...>, Cmpts...>
     {
     public:
+        // `View<A, B>::Exclude<C, D>` - entities with A and B, but without C or D.
+        template <typename ... MoreEx>
+        using Exclude = BasicView<ExcludeList<Ex..., MoreEx...>, Cmpts...>;
+
         struct Iterator
         {
-            friend class View;
+            friend class BasicView;
         public:
             using iterator_category = std::forward_iterator_tag;
             using difference_type = I32;
@@ -22,11 +56,8 @@ namespace Engine
             using pointer = value_type*;
             using reference = value_type&;
 
-            Iterator(const Registry& registry, const std::array<U64, sizeof ...(Cmpts)>& compIds,
-                     const ComponentPool* refPool,
-                     I32 entityIndex, bool allEntities)
-                : Registry(registry), ComponentIds(compIds), ReferencePool(refPool),
-                  ReferencePoolCurrentEntityIndex(entityIndex), AllEntities(allEntities)
+            Iterator(const BasicView* owner, const ComponentPool* refPool, I32 entityIndex)
+                : Owner(owner), ReferencePool(refPool), ReferencePoolCurrentEntityIndex(entityIndex)
             {
             }
 
@@ -48,94 +79,232 @@ namespace Engine
             Iterator& operator++()
             {
                 ReferencePoolCurrentEntityIndex--;
-                if (!AllEntities)
+                const auto& dense = ReferencePool->GetDenseEntities();
+                while (ReferencePoolCurrentEntityIndex >= 0 &&
+                    !Owner->IsAccepted(dense[ReferencePoolCurrentEntityIndex], ReferencePoolCurrentEntityIndex))
                 {
-                    while (ReferencePoolCurrentEntityIndex >= 0 &&
-                        !IsInAllComponents(ReferencePool->GetDenseEntities()[ReferencePoolCurrentEntityIndex]))
-                    {
-                        ReferencePoolCurrentEntityIndex--;
-                    }
+                    ReferencePoolCurrentEntityIndex--;
                 }
                 return *this;
             }
 
         private:
-            bool IsInAllComponents(Entity entityId)
-            {
-                for (auto& cId : ComponentIds)
-                {
-                    if (!Registry.GetComponentPool(cId).Has(entityId))
-                    {
-                        return false;
-                    }
-                }
-                return true;
-            }
-            bool IsValid()
+            bool IsValid() const
             {
-                return IsInAllComponents(ReferencePool->GetDenseEntities()[ReferencePoolCurrentEntityIndex]);
+                return Owner->IsAccepted(ReferencePool->GetDenseEntities()[ReferencePoolCurrentEntityIndex],
+                    ReferencePoolCurrentEntityIndex);
             }
 
         public:
-            const Registry& Registry;
-            std::array<U64, sizeof ...(Cmpts)> ComponentIds;
+            const BasicView* Owner = nullptr;
             // Reference pool is the one we take EntityId objects from.
             const ComponentPool* ReferencePool = nullptr;
             I32 ReferencePoolCurrentEntityIndex;
-            bool AllEntities = false;
         };
 
     public:
-        View(const Registry& registry)
+        BasicView(const Registry& registry)
             : m_Registry(registry)
         {
-            if (sizeof ...(Cmpts) == 0)
+            std::array<U64, sizeof ...(Ex)> excludedIds = {{ComponentFamily::TYPE<Ex>...}};
+            for (auto id : excludedIds)
+            {
+                // Components with no pool cannot be in any signature.
+                if (m_Registry.IsComponentExists(id)) m_Exclude.set(id);
+            }
+            std::array<U64, sizeof ...(Cmpts)> componentIds = {{ComponentFamily::TYPE<typename ViewComponentTraits<Cmpts>::Type>...}};
+            std::array<bool, sizeof ...(Cmpts)> isOptional = {{ViewComponentTraits<Cmpts>::IS_OPTIONAL...}};
+            // Check that registry actually has all (not optional) components.
+            for (U32 i = 0; i < componentIds.size(); i++)
+            {
+                if (!isOptional[i] && !m_Registry.IsComponentExists(componentIds[i])) return;
+            }
+            for (U32 i = 0; i < componentIds.size(); i++)
+            {
+                if (!m_Registry.IsComponentExists(componentIds[i])) continue;
+                m_Pools[i] = &m_Registry.GetComponentPool(componentIds[i]);
+                if (isOptional[i]) continue;
+                m_Include.set(componentIds[i]);
+                // The smallest pool is the reference one, as we iterate over its entities.
+                if (m_ReferencePool == nullptr || m_Pools[i]->GetComponentCount() < m_ReferencePool->GetComponentCount())
+                {
+                    m_ReferencePool = m_Pools[i];
+                }
+            }
+            if (m_ReferencePool == nullptr)
             {
-                m_AllEntities = true;
                 // If we wish to return all entities, the simplest way is
                 // to iterate over entities of component pool, that has every entity,
                 // in our case it is either "name" component or "transform2d" component,
                 // however when moving outside of 2d-only, only "name" component will do.
                 m_ReferencePool = &m_Registry.GetComponentPool<Component::Name>();
             }
-            else
+        }
+
+        // Returns the copy of view, that keeps only entities, whose `T` component was changed
+        // after `sinceTick` (see `Registry::AdvanceChangeTick`). `T`'s pool becomes the reference one,
+        // so that pages without changes are skipped as a whole.
+        template <typename T>
+        BasicView Changed(U32 sinceTick) const
+        {
+            BasicView view = *this;
+            if (view.m_ReferencePool == nullptr) return view;
+            const U64 componentId = ComponentFamily::TYPE<T>;
+            if (!m_Registry.IsComponentExists(componentId))
             {
-                m_ComponentIds = {{ComponentFamily::TYPE<Cmpts>...}};
-                // Check that registry actually has all components.
-                for (auto id : m_ComponentIds)
-                {
-                    if (!m_Registry.IsComponentExists(id)) return;
-                }
-                // Sort the components based on how many entities are in them,
-                // for faster search.
-                std::sort(m_ComponentIds.begin(), m_ComponentIds.end(), [this](auto& a, auto& b)
-                {
-                    return m_Registry.GetComponentPool(a).GetComponentCount() <
-                        m_Registry.GetComponentPool(b).GetComponentCount();
-                });
-                m_ReferencePool = &m_Registry.GetComponentPool(m_ComponentIds.front());
+                view.m_ReferencePool = nullptr;
+                return view;
             }
+            view.m_Include.set(componentId);
+            view.m_ReferencePool = &m_Registry.GetComponentPool(componentId);
+            view.m_ChangedFilters.push_back({view.m_ReferencePool, sinceTick});
+            return view;
         }
 
         Iterator begin() const
         {
-            if (m_ReferencePool == nullptr) return end();
-            auto begin = Iterator(m_Registry, m_ComponentIds, m_ReferencePool, static_cast<U32>(m_ReferencePool->GetDenseEntities().size()) - 1, m_AllEntities);
+            if (m_ReferencePool == nullptr || !HasAnyChanges()) return end();
+            auto begin = Iterator(this, m_ReferencePool, static_cast<I32>(m_ReferencePool->GetDenseEntities().size()) - 1);
             while (begin != end() && !begin.IsValid()) ++begin;
             return begin;
         }
 
         Iterator end() const
         {
-            return Iterator(m_Registry, m_ComponentIds, m_ReferencePool,
-                            -1, m_AllEntities);
+            return Iterator(this, m_ReferencePool, -1);
+        }
+
+        // Calls `fn(entity, components&...)` (or `fn(components&...)`) for every entity of the view,
+        // `Optional<T>` components are passed as `T*`.
+        // Walks the reference pool's dense array directly, so its components are taken without any
+        // sparse lookup, entities are filtered by signature, and every other component costs a single sparse probe.
+        // Like iterator, goes from the back, so it is safe to delete the current entity inside `fn`.
+        // Writes are not change-tracked, use `Registry::MarkChanged` if needed.
+        template <typename Fn>
+        void Each(Fn fn) const
+        {
+            if (m_ReferencePool == nullptr || !HasAnyChanges()) return;
+            EachImpl(fn, 0, m_ReferencePool->GetComponentCount(), std::index_sequence_for<Cmpts...>{});
+        }
+
+        // Same as `Each`, but the reference pool is split into ranges of whole pages
+        // (`grainSize` is rounded up to `SPARSE_SET_PAGE_SIZE`), that are processed on worker threads.
+        // `fn` shall only touch the data of its entity, structural changes are forbidden.
+        template <typename Fn>
+        void ParallelEach(Fn fn, U32 grainSize = SPARSE_SET_PAGE_SIZE) const
+        {
+            if (m_ReferencePool == nullptr || !HasAnyChanges()) return;
+            grainSize = std::max(1u, (grainSize + SPARSE_SET_PAGE_SIZE - 1) >> SPARSE_SET_PAGE_SIZE_LOG) << SPARSE_SET_PAGE_SIZE_LOG;
+            m_Registry.LockStructuralChanges();
+            JobSystem::ParallelFor(m_ReferencePool->GetComponentCount(), grainSize, [this, &fn](U32 begin, U32 end)
+            {
+                EachImpl(fn, begin, end, std::index_sequence_for<Cmpts...>{});
+            });
+            m_Registry.UnlockStructuralChanges();
+        }
+
+    private:
+        struct ChangedFilter
+        {
+            const ComponentPool* Pool;
+            U32 SinceTick;
+        };
+
+        bool IsAccepted(Entity entity, U32 referenceIndex) const
+        {
+            // Tombstone of pointer-stable pool.
+            if (entity == NULL_ENTITY) return false;
+            const ComponentMask& signature = m_Registry.GetEntityManager().GetSignature(entity);
+            if ((signature & m_Include) != m_Include || (signature & m_Exclude).any()) return false;
+            for (auto& filter : m_ChangedFilters)
+            {
+                U32 componentIndex = filter.Pool == m_ReferencePool ?
+                    referenceIndex : filter.Pool->TryGetComponentIndex(entity);
+                if (filter.Pool->GetComponentChangeTick(componentIndex) <= filter.SinceTick) return false;
+            }
+            return true;
+        }
+
+        bool HasAnyChanges() const
+        {
+            return std::ranges::all_of(m_ChangedFilters, [](auto& filter)
+            {
+                return filter.Pool->GetChangeTick() > filter.SinceTick;
+            });
+        }
+
+        // Reference pool is the last filtered by `Changed`, so whole page can be checked at once.
+        bool IsPageUnchanged(U32 referenceIndex) const
+        {
+            return !m_ChangedFilters.empty() &&
+                m_ReferencePool->GetPageChangeTick(referenceIndex >> SPARSE_SET_PAGE_SIZE_LOG) <= m_ChangedFilters.back().SinceTick;
+        }
+
+        template <typename Fn, U64 ... Indices>
+        void EachImpl(Fn& fn, U32 begin, U32 end, std::index_sequence<Indices...>) const
+        {
+            const auto& dense = m_ReferencePool->GetDenseEntities();
+            for (I32 i = static_cast<I32>(end) - 1; i >= static_cast<I32>(begin); i--)
+            {
+                // Callback is allowed to delete entities, so the dense array may shrink by more than one.
+                if (i >= static_cast<I32>(dense.size())) continue;
+                if (IsPageUnchanged(static_cast<U32>(i)))
+                {
+                    // Go to the last element of previous page.
+                    i &= ~static_cast<I32>(SPARSE_SET_PAGE_SIZE - 1);
+                    continue;
+                }
+                Entity entity = dense[i];
+                if (!IsAccepted(entity, static_cast<U32>(i))) continue;
+                std::array<U32, sizeof ...(Cmpts)> componentIndices{};
+                for (U32 poolI = 0; poolI < m_Pools.size(); poolI++)
+                {
+                    if (m_Pools[poolI] == nullptr) continue;
+                    componentIndices[poolI] = m_Pools[poolI] == m_ReferencePool ?
+                        static_cast<U32>(i) : m_Pools[poolI]->TryGetComponentIndex(entity);
+                }
+                if constexpr (std::is_invocable_v<Fn&, Entity, typename ViewComponentTraits<Cmpts>::Accessor...>)
+                {
+                    fn(entity, GetAccessor<Indices>(componentIndices[Indices])...);
+                }
+                else
+                {
+                    fn(GetAccessor<Indices>(componentIndices[Indices])...);
+                }
+            }
+        }
+
+        template <U64 Index>
+        auto GetAccessor(U32 componentIndex) const -> typename ViewComponentTraits<std::tuple_element_t<Index, std::tuple<Cmpts...>>>::Accessor
+        {
+            using Traits = ViewComponentTraits<std::tuple_element_t<Index, std::tuple<Cmpts...>>>;
+            using T = typename Traits::Type;
+            if constexpr (Traits::IS_OPTIONAL)
+            {
+                if (m_Pools[Index] == nullptr || componentIndex == m_Pools[Index]->GetNullIndex()) return nullptr;
+                return &const_cast<T&>(m_Pools[Index]->template GetComponent<T>(componentIndex));
+            }
+            else if constexpr (SoaComponent<T>)
+            {
+                return m_Pools[Index]->template GetComponent<T>(componentIndex);
+            }
+            else
+            {
+                return const_cast<T&>(m_Pools[Index]->template GetComponent<T>(componentIndex));
+            }
         }
 
     private:
         const Registry& m_Registry;
-        std::array<U64, sizeof ...(Cmpts)> m_ComponentIds;
+        // Pools in the order of `Cmpts` (optional ones may be nullptr).
+        std::array<const ComponentPool*, sizeof ...(Cmpts)> m_Pools{};
+        ComponentMask m_Include{};
+        ComponentMask m_Exclude{};
+        std::vector<ChangedFilter> m_ChangedFilters{};
         // Reference pool is the one we take EntityId objects from.
         const ComponentPool* m_ReferencePool = nullptr;
-        bool m_AllEntities = false;
     };
+
+    template <typename ... Cmpts>
+    using View = BasicView<ExcludeList<>, Cmpts...>;
 }
@@ -19,4 +19,15 @@ namespace Engine::Math
         }
         return hash;
     }
+
+    constexpr U64 HashString(std::string_view string, U64 offsetBasis = FNV_OFFSET_BASIS)
+    {
+        U64 hash = offsetBasis;
+        for (char c : string)
+        {
+            hash = hash ^ static_cast<U64>(static_cast<U8>(c));
+            hash = hash * FNV_PRIME;
+        }
+        return hash;
+    }
 }
\ No newline at end of file
@@ -15,17 +15,20 @@ namespace Engine::Math
 	using namespace Types;
 	inline U32 CLZ(U32 number)
 	{
+#			ifdef _MSC_VER
 		return __lzcnt(number);
-#			ifndef _MSC_VER
-		return __builtin_clz(number);
+#			else
+		// Unlike `lzcnt`, the builtin is undefined for 0.
+		return number == 0 ? 32 : static_cast<U32>(__builtin_clz(number));
 #			endif
 	}
 
 	inline U64 CLZ(U64 number)
 	{
+#			ifdef _MSC_VER
 		return __lzcnt64(number);
-#			ifndef _MSC_VER
-		return __builtin_clz(number);
+#			else
+		return number == 0 ? 64 : static_cast<U64>(__builtin_clzll(number));
 #			endif
 	}
 
@@ -3,9 +3,8 @@
 
 namespace Engine
 {
-    std::random_device Random::m_Device;
-    std::mt19937 Random::m_Mt(Random::m_Device());
-    std::uniform_real_distribution<> Random::m_UniformNormalizedReal(0.0f, 1.0f);
+    thread_local std::mt19937 Random::m_Mt(std::random_device{}());
+    thread_local std::uniform_real_distribution<> Random::m_UniformNormalizedReal(0.0f, 1.0f);
 
     F32 Random::Float()
     {
@@ -49,13 +48,13 @@ namespace Engine
 
     I32 Random::Int32()
     {
-        static std::uniform_int_distribution<I32> distrib(std::numeric_limits<I32>::min(), std::numeric_limits<I32>::max());
+        thread_local std::uniform_int_distribution<I32> distrib(std::numeric_limits<I32>::min(), std::numeric_limits<I32>::max());
         return distrib(m_Mt);
     }
 
     U32 Random::UInt32()
     {
-        static std::uniform_int_distribution<U32> distrib(std::numeric_limits<U32>::min(), std::numeric_limits<U32>::max());
+        thread_local std::uniform_int_distribution<U32> distrib(std::numeric_limits<U32>::min(), std::numeric_limits<U32>::max());
         return distrib(m_Mt);
     }
 
@@ -73,13 +72,13 @@ namespace Engine
 
     I64 Random::Int64()
     {
-        static std::uniform_int_distribution<I64> distrib(std::numeric_limits<I64>::min(), std::numeric_limits<I64>::max());
+        thread_local std::uniform_int_distribution<I64> distrib(std::numeric_limits<I64>::min(), std::numeric_limits<I64>::max());
         return distrib(m_Mt);
     }
 
     U64 Random::UInt64()
     {
-        static std::uniform_int_distribution<U64> distrib(std::numeric_limits<U64>::min(), std::numeric_limits<U64>::max());
+        thread_local std::uniform_int_distribution<U64> distrib(std::numeric_limits<U64>::min(), std::numeric_limits<U64>::max());
         return distrib(m_Mt);
     }
 
@@ -91,7 +90,7 @@ namespace Engine
 
     U64 Random::UInt64(U64 left, U64 right)
     {
-        static std::uniform_int_distribution<U64> distrib(left, right);
+        std::uniform_int_distribution<U64> distrib(left, right);
         return distrib(m_Mt);
     }
 }
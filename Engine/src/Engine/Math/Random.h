@@ -8,6 +8,7 @@
 namespace Engine
 {
 	using namespace Types;
+	// Every thread has its own engine, so that systems running in parallel can use it.
 	class Random
 	{
 	public:
@@ -30,8 +31,7 @@ namespace Engine
 		static U64 UInt64(U64 left, U64 right);
 		
 		private:
-		static std::random_device m_Device;
-		static std::mt19937 m_Mt;
-		static std::uniform_real_distribution<> m_UniformNormalizedReal;
+		static thread_local std::mt19937 m_Mt;
+		static thread_local std::uniform_real_distribution<> m_UniformNormalizedReal;
 	};
 }
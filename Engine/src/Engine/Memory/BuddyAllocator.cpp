@@ -17,7 +17,7 @@ namespace Engine
 		ENGINE_CORE_ASSERT((sizeBytes & (sizeBytes - 1)) == 0 && (leafSizeBytes & (leafSizeBytes - 1)) == 0,
 			"Buddy allocator size and leafsize have to be the power of 2.");
 		m_Levels = static_cast<U32>(Math::Log2(sizeBytes / leafSizeBytes));
-		m_Memory = reinterpret_cast<U8*>(MemoryUtils::AllocAligned(sizeBytes, 256));
+		m_Memory = reinterpret_cast<U8*>(MemoryUtils::AllocAligned(sizeBytes, MEMORY_REGION_ALIGNMENT));
 		m_LevelsMap = std::vector<U64>((U64(1) << (m_Levels + 1)) / 12, 0);
 
 		// Cast 1 to U64 to remove annoying overflow warning.
@@ -156,8 +156,9 @@ namespace Engine
 		sizeBytes = std::max(sizeBytes, BUDDY_ALLOCATOR_INCREMENT_BYTES);
 		ENGINE_CORE_INFO("{}: requesting {} bytes of memory from the system.", m_DebugName, sizeBytes);
 		m_NextBuddyAllocator = new (MemoryUtils::AllocAligned(sizeof(BuddyAllocator), 256)) BuddyAllocator(sizeBytes, m_LeafSizeBytes);
-		// Callback is defined in memory manager.
-		m_CallbackFn();
+		// Callback is defined in memory manager, the next allocator reports its own expansions with it too.
+		m_NextBuddyAllocator->SetExpandCallback(m_CallbackFn, m_CallbackUserData);
+		m_CallbackFn(m_CallbackUserData, m_NextBuddyAllocator->m_Memory, m_NextBuddyAllocator->m_TotalSizeBytes);
 	}
 
 	void* BuddyAllocator::AllocBlock(U32 level)
@@ -0,0 +1,116 @@
+#include "enginepch.h"
+
+#include "FrameAllocator.h"
+#include "MemoryUtils.h"
+#include "Engine/Core/Core.h"
+#include "Engine/Core/Log.h"
+
+namespace Engine
+{
+	FrameAllocator::Arena FrameAllocator::s_Arenas[FRAME_ALLOCATOR_FRAMES];
+	U64 FrameAllocator::s_ArenaSize = 0;
+	U64 FrameAllocator::s_ThreadArenaSize = 0;
+	std::atomic<U64> FrameAllocator::s_FrameIndex{0};
+	std::mutex FrameAllocator::s_OverflowMutex;
+
+	FrameAllocator::ThreadArenas::ThreadArenas()
+	{
+		for (auto& arena : Arenas)
+			arena.Memory = static_cast<U8*>(MemoryUtils::AllocAligned(s_ThreadArenaSize, MEMORY_REGION_ALIGNMENT));
+	}
+
+	FrameAllocator::ThreadArenas::~ThreadArenas()
+	{
+		for (auto& arena : Arenas) MemoryUtils::FreeAligned(arena.Memory);
+	}
+
+	void FrameAllocator::Init(U64 arenaSizeBytes, U64 threadArenaSizeBytes)
+	{
+		s_ArenaSize = arenaSizeBytes;
+		s_ThreadArenaSize = threadArenaSizeBytes;
+		for (auto& arena : s_Arenas)
+		{
+			arena.Memory = static_cast<U8*>(MemoryUtils::AllocAligned(arenaSizeBytes, MEMORY_REGION_ALIGNMENT));
+			arena.Marker.store(0, std::memory_order_relaxed);
+		}
+		s_FrameIndex.store(0, std::memory_order_relaxed);
+	}
+
+	void FrameAllocator::ShutDown()
+	{
+		for (auto& arena : s_Arenas)
+		{
+			ResetArena(arena);
+			MemoryUtils::FreeAligned(arena.Memory);
+			arena.Memory = nullptr;
+		}
+	}
+
+	void FrameAllocator::BeginFrame()
+	{
+		const U64 frame = s_FrameIndex.load(std::memory_order_relaxed) + 1;
+		Arena& arena = s_Arenas[frame % FRAME_ALLOCATOR_FRAMES];
+		if (arena.OverflowBytes > 0)
+		{
+			ENGINE_CORE_WARN("Frame allocator: {} bytes did not fit into the arena ({} bytes), consider increasing its size.",
+				arena.OverflowBytes, s_ArenaSize);
+		}
+		ResetArena(arena);
+		s_FrameIndex.store(frame, std::memory_order_release);
+	}
+
+	void* FrameAllocator::Alloc(U64 sizeBytes, U16 alignment)
+	{
+		ENGINE_CORE_ASSERT(s_Arenas[0].Memory != nullptr, "Frame allocator is not initialized.")
+		Arena& arena = s_Arenas[s_FrameIndex.load(std::memory_order_acquire) % FRAME_ALLOCATOR_FRAMES];
+		const uintptr_t base = reinterpret_cast<uintptr_t>(arena.Memory);
+		U64 marker = arena.Marker.load(std::memory_order_relaxed);
+		U64 offset;
+		do
+		{
+			offset = MemoryUtils::AlignAdress(base + marker, alignment) - base;
+			if (offset + sizeBytes > s_ArenaSize) return AllocOverflow(arena, sizeBytes, alignment);
+		}
+		while (!arena.Marker.compare_exchange_weak(marker, offset + sizeBytes, std::memory_order_relaxed));
+
+		return arena.Memory + offset;
+	}
+
+	void* FrameAllocator::AllocThread(U64 sizeBytes, U16 alignment)
+	{
+		thread_local ThreadArenas threadArenas;
+		const U64 frame = s_FrameIndex.load(std::memory_order_acquire);
+		const U32 index = frame % FRAME_ALLOCATOR_FRAMES;
+		ThreadArena& arena = threadArenas.Arenas[index];
+		// Arena was used `FRAME_ALLOCATOR_FRAMES` (or more) frames ago.
+		if (arena.Frame != frame)
+		{
+			arena.Marker = 0;
+			arena.Frame = frame;
+		}
+		const uintptr_t base = reinterpret_cast<uintptr_t>(arena.Memory);
+		const U64 offset = MemoryUtils::AlignAdress(base + arena.Marker, alignment) - base;
+		if (offset + sizeBytes > s_ThreadArenaSize) return AllocOverflow(s_Arenas[index], sizeBytes, alignment);
+		arena.Marker = offset + sizeBytes;
+
+		return arena.Memory + offset;
+	}
+
+	void* FrameAllocator::AllocOverflow(Arena& arena, U64 sizeBytes, U16 alignment)
+	{
+		void* memory = MemoryUtils::AllocAligned(sizeBytes, alignment);
+		std::lock_guard lock(s_OverflowMutex);
+		arena.Overflow.push_back(memory);
+		arena.OverflowBytes += sizeBytes;
+		return memory;
+	}
+
+	void FrameAllocator::ResetArena(Arena& arena)
+	{
+		std::lock_guard lock(s_OverflowMutex);
+		for (auto* memory : arena.Overflow) MemoryUtils::FreeAligned(memory);
+		arena.Overflow.clear();
+		arena.OverflowBytes = 0;
+		arena.Marker.store(0, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Engine/Core/Types.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine
+{
+	using namespace Types;
+	// Memory of a frame is valid until `FRAME_ALLOCATOR_FRAMES` frames later.
+	static constexpr U32 FRAME_ALLOCATOR_FRAMES = 2;
+	// Default arena sizes, `Init` takes the actual ones.
+	static U64 FRAME_ALLOCATOR_DEFAULT_SIZE = 8_MiB;
+	static U64 FRAME_ALLOCATOR_THREAD_DEFAULT_SIZE = 1_MiB;
+
+	// Ring of `FRAME_ALLOCATOR_FRAMES` linear arenas for transient (single frame) allocations,
+	// the arena of the frame is reset by `BeginFrame` (called by `Application`), deallocation is not needed.
+	// Allocations that do not fit the arena are served by the system, and freed on the reset of the arena.
+	class FrameAllocator
+	{
+	public:
+		// Shall be called in entry point.
+		static void Init(U64 arenaSizeBytes = FRAME_ALLOCATOR_DEFAULT_SIZE, U64 threadArenaSizeBytes = FRAME_ALLOCATOR_THREAD_DEFAULT_SIZE);
+
+		// Shall be called in entry point (frees memory).
+		static void ShutDown();
+
+		// Advances to the next arena of the ring and resets it (memory allocated `FRAME_ALLOCATOR_FRAMES` frames ago is reclaimed).
+		// Shall not be called while other threads allocate.
+		static void BeginFrame();
+
+		// Thread-safe (lock-free bump of the shared arena).
+		static void* Alloc(U64 sizeBytes, U16 alignment = alignof(std::max_align_t));
+
+		template <typename T>
+		static T* Alloc(U64 count = 1) { return static_cast<T*>(Alloc(count * sizeof(T), alignof(T))); }
+
+		// Allocates from the arenas of the calling thread (no synchronization), they are reset lazily on the first allocation of the frame.
+		static void* AllocThread(U64 sizeBytes, U16 alignment = alignof(std::max_align_t));
+
+		template <typename T>
+		static T* AllocThread(U64 count = 1) { return static_cast<T*>(AllocThread(count * sizeof(T), alignof(T))); }
+
+		static U64 GetFrameIndex() { return s_FrameIndex.load(std::memory_order_relaxed); }
+
+	private:
+		struct Arena
+		{
+			U8* Memory{nullptr};
+			std::atomic<U64> Marker{0};
+			// Allocations that did not fit into arena.
+			std::vector<void*> Overflow;
+			U64 OverflowBytes{0};
+		};
+
+		struct ThreadArena
+		{
+			U8* Memory{nullptr};
+			U64 Marker{0};
+			// Frame index the arena was last reset for.
+			U64 Frame{0};
+		};
+
+		struct ThreadArenas
+		{
+			ThreadArenas();
+			~ThreadArenas();
+			ThreadArena Arenas[FRAME_ALLOCATOR_FRAMES];
+		};
+
+		static void* AllocOverflow(Arena& arena, U64 sizeBytes, U16 alignment);
+		static void ResetArena(Arena& arena);
+
+	private:
+		static Arena s_Arenas[FRAME_ALLOCATOR_FRAMES];
+		static U64 s_ArenaSize;
+		static U64 s_ThreadArenaSize;
+		static std::atomic<U64> s_FrameIndex;
+		static std::mutex s_OverflowMutex;
+	};
+
+	// Allocator for STL containers, that live no longer than `FRAME_ALLOCATOR_FRAMES` frames.
+	template <typename T, bool IsPerThread = false>
+	class FrameStlAllocator
+	{
+	public:
+		using value_type = T;
+		template <typename U>
+		struct rebind { using other = FrameStlAllocator<U, IsPerThread>; };
+
+		FrameStlAllocator() = default;
+		template <typename U>
+		FrameStlAllocator(const FrameStlAllocator<U, IsPerThread>&) {}
+
+		T* allocate(U64 count)
+		{
+			if constexpr (IsPerThread) return FrameAllocator::AllocThread<T>(count);
+			else return FrameAllocator::Alloc<T>(count);
+		}
+		// Memory is reclaimed on the reset of the arena.
+		void deallocate(T*, U64) {}
+
+		template <typename U>
+		bool operator==(const FrameStlAllocator<U, IsPerThread>&) const { return true; }
+		template <typename U>
+		bool operator!=(const FrameStlAllocator<U, IsPerThread>&) const { return false; }
+	};
+
+	template <typename T, bool IsPerThread = false>
+	using FrameVector = std::vector<T, FrameStlAllocator<T, IsPerThread>>;
+
+	template <typename K, typename V, bool IsPerThread = false>
+	using FrameUnorderedMap = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, FrameStlAllocator<std::pair<const K, V>, IsPerThread>>;
+}
@@ -11,7 +11,7 @@ namespace Engine
 		m_DebugName("Freelist allocator")
 	{
 		ENGINE_ASSERT(sizeBytes >= FreelistHolder::MinSize(), "Freelist allocator must be larger.");
-		void* freelistMemory = MemoryUtils::AllocAligned(sizeBytes);
+		void* freelistMemory = MemoryUtils::AllocAligned(sizeBytes, MEMORY_REGION_ALIGNMENT);
 
 		m_NullTreeElement = reinterpret_cast<RedBlackTreeElement*>(MemoryUtils::AllocAligned(sizeof(RedBlackTreeElement), alignof(RedBlackTreeElement)));
 		m_NullTreeElement->Left = m_NullTreeElement->Right = m_NullTreeElement;
@@ -148,7 +148,7 @@ namespace Engine
 
 		ENGINE_CORE_INFO("{}: requesting {} bytes of memory from the system.", m_DebugName, sizeBytes);
 
-		void* freelistExtension = MemoryUtils::AllocAligned(sizeBytes);
+		void* freelistExtension = MemoryUtils::AllocAligned(sizeBytes, MEMORY_REGION_ALIGNMENT);
 
 		FreelistHolder* newHolder = reinterpret_cast<FreelistHolder*>(GetInitializedFreelistHolder(freelistExtension, sizeBytes));
 		newHolder->Next = m_FirstFreelistHolder;
@@ -159,7 +159,7 @@ namespace Engine
 		InsertRB(newHolder->FirstNode->RBElement());
 
 		// Callback is defined in memory manager.
-		m_CallbackFn();
+		m_CallbackFn(m_CallbackUserData, freelistExtension, sizeBytes);
 
 		return static_cast<void*>(newHolder->FirstNode);
 	}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "MemoryUtils.h"
 #include "Engine/Core/Types.h"
 
 namespace Engine
@@ -39,7 +40,7 @@ namespace Engine
 
 		// TODO: custom container
 		std::vector<U64> GetMemoryBounds() const;
-		void SetExpandCallback(void (*callbackFn)()) { m_CallbackFn = callbackFn; }
+		void SetExpandCallback(MemoryExpandCallbackFn callbackFn, U64 userData) { m_CallbackFn = callbackFn; m_CallbackUserData = userData; }
 	private:
 		struct FreelistNode;
 		struct RedBlackTreeElement;
@@ -128,6 +129,7 @@ namespace Engine
 		std::string m_DebugName;
 
 		// This is my favourite line.
-		void (*m_CallbackFn)() = [](){};
+		MemoryExpandCallbackFn m_CallbackFn = [](U64, void*, U64){};
+		U64 m_CallbackUserData{0};
 	};
 }
\ No newline at end of file
@@ -1,28 +1,67 @@
 #include "enginepch.h"
 
 #include "MemoryManager.h"
+#include "MemoryResource.h"
 #include "Engine/Core/Log.h"
 
 namespace Engine
 {
 	std::vector<MemoryManager::MarkedAllocator> MemoryManager::s_Allocators;
+	std::array<MemoryManager::SizeClass, 65> MemoryManager::s_SizeClasses;
+	std::array<PoolAllocator*, POOL_MAX_SIZE_CLASS + 1> MemoryManager::s_Pools;
+	BuddyAllocator* MemoryManager::s_BuddyAllocator;
+	FreelistRedBlackAllocator* MemoryManager::s_FreelistAllocator;
+	std::array<std::mutex, POOL_MAX_SIZE_CLASS + 1> MemoryManager::s_PoolMutexes;
+	std::mutex MemoryManager::s_BuddyMutex;
+	std::mutex MemoryManager::s_FreelistMutex;
 	std::vector<Ref<MemoryManager::ManagedPoolAllocator>>  MemoryManager::s_ManagedPools;
-	
-	std::vector<MarkedInterval> MemoryManager::s_MarkedIntervals;
-	bool MemoryManager::s_IsPendingProbe;
-	MemoryManager::MemoryManagerStats MemoryManager::s_Stats;
+	PageMap MemoryManager::s_PageMap;
+	std::mutex MemoryManager::s_PageMapMutex;
+	std::vector<MemoryManager::ThreadCache*> MemoryManager::s_ThreadCaches;
+	MemoryManager::MemoryManagerStats MemoryManager::s_FinishedThreadsStats;
+	std::mutex MemoryManager::s_ThreadCachesMutex;
+	bool MemoryManager::s_IsInitialized{false};
 
-	void MemoryManager::Init()
+	MemoryManager::ThreadCache::ThreadCache()
+	{
+		std::lock_guard lock(s_ThreadCachesMutex);
+		s_ThreadCaches.push_back(this);
+	}
+
+	MemoryManager::ThreadCache::~ThreadCache()
+	{
+		std::lock_guard lock(s_ThreadCachesMutex);
+		if (s_IsInitialized) Flush();
+		AddStats(s_FinishedThreadsStats, *this);
+		std::erase(s_ThreadCaches, this);
+	}
+
+	void MemoryManager::ThreadCache::Flush()
 	{
-		s_IsPendingProbe = true;
+		for (U32 poolIndex = POOL_MIN_SIZE_CLASS; poolIndex <= POOL_MAX_SIZE_CLASS; poolIndex++)
+		{
+			Magazine& magazine = Magazines[poolIndex];
+			if (magazine.Count == 0) continue;
+			std::lock_guard lock(s_PoolMutexes[poolIndex]);
+			while (magazine.Count > 0) s_Pools[poolIndex]->Dealloc(magazine.Blocks[--magazine.Count]);
+		}
+	}
 
-		U64 allocatorId = 0;
+	void MemoryManager::Init()
+	{
 		BuddyAllocator* buddyAlloc = new BuddyAllocator(BUDDY_DEFAULT_SIZE_BYTES, BUDDY_ALLOCATOR_DEFAULT_LEAF_SIZE_BYTES);
-		s_Allocators.push_back({ buddyAlloc, allocatorId++, 128_MiB });
+		s_Allocators.push_back({ buddyAlloc, 128_MiB });
 		FreelistRedBlackAllocator* freeTreeAlloc = new FreelistRedBlackAllocator(2_MiB);
-		s_Allocators.push_back({ freeTreeAlloc, allocatorId++, std::numeric_limits<U64>::max() });
+		s_Allocators.push_back({ freeTreeAlloc, std::numeric_limits<U64>::max() });
+
+		s_BuddyAllocator = buddyAlloc;
+		s_FreelistAllocator = freeTreeAlloc;
+		for (U32 sizeClass = 0; sizeClass < s_SizeClasses.size(); sizeClass++)
+		{
+			s_SizeClasses[sizeClass].Allocator = sizeClass <= BUDDY_MAX_SIZE_CLASS ? SizeClassAllocator::Buddy : SizeClassAllocator::Freelist;
+		}
 
-		for (U32 pow = 3; pow <= 10; pow++)
+		for (U32 pow = POOL_MIN_SIZE_CLASS; pow <= POOL_MAX_SIZE_CLASS; pow++)
 		{
 			U64 poolSize = U64(1) << pow;
 			PoolAllocator* allocator = nullptr;
@@ -36,22 +75,44 @@ namespace Engine
 			}
 			allocator->SetDebugName("Pool" + std::to_string(poolSize));
 
-			s_Allocators.push_back({ allocator, allocatorId++, poolSize });
+			s_Allocators.push_back({ allocator, poolSize });
+			// The smallest pool also takes all smaller sizes.
+			for (U32 sizeClass = pow == POOL_MIN_SIZE_CLASS ? 0 : pow; sizeClass <= pow; sizeClass++)
+			{
+				s_SizeClasses[sizeClass] = { SizeClassAllocator::Pool, pow };
+			}
+			s_Pools[pow] = allocator;
 		}
 
 		std::sort(s_Allocators.begin(), s_Allocators.end(), [](auto& a, auto& b) { return a.HigherBound < b.HigherBound; });
 
-		for (auto&& markAlloc : s_Allocators)
+		ENGINE_CORE_ASSERT(s_Allocators.size() < PageMap::NULL_VALUE, "Too many allocators for page map.")
+		for (U64 allocatorIndex = 0; allocatorIndex < s_Allocators.size(); allocatorIndex++)
 		{
-			std::visit([](auto&& alloc) {
-				alloc->SetExpandCallback([]() { MemoryManager::s_IsPendingProbe = true; });
-			}, markAlloc.Allocator);
+			std::visit([allocatorIndex](auto&& alloc) {
+				std::vector<U64> memoryBounds = alloc->GetMemoryBounds();
+				for (U64 memIndex = 0; memIndex < memoryBounds.size(); memIndex += 2)
+				{
+					s_PageMap.Set(memoryBounds[memIndex], memoryBounds[memIndex + 1], static_cast<U8>(allocatorIndex));
+				}
+				alloc->SetExpandCallback(OnAllocatorExpand, allocatorIndex);
+			}, s_Allocators[allocatorIndex].Allocator);
 		}
+		s_IsInitialized = true;
 	}
 
 	void MemoryManager::ShutDown()
 	{
 		PrintPoolsStats();
+		{
+			// Other threads shall not allocate anymore, blocks in their magazines are freed with pools.
+			std::lock_guard lock(s_ThreadCachesMutex);
+			for (ThreadCache* cache : s_ThreadCaches)
+			{
+				for (auto& magazine : cache->Magazines) magazine.Count = 0;
+			}
+			s_IsInitialized = false;
+		}
 		// Delete all managed pools.
 		for (auto& pool : s_ManagedPools)
 		{
@@ -64,56 +125,136 @@ namespace Engine
 				delete alloc;
 			}, markAlloc.Allocator);
 		}
+		s_Allocators.clear();
+		s_PageMap.Clear();
 		PrintStats();
 	}
 
 	void* MemoryManager::Alloc(U64 sizeBytes)
 	{
-		s_Stats.TotalAllocations++;
-		s_Stats.TotalAllocationsBytes += sizeBytes;
-		AllocationDispatcher dispatcher(sizeBytes);
-		for (auto&& markAlloc : s_Allocators)
+		ThreadCache& cache = GetThreadCache();
+		AddStat(cache.TotalAllocations, 1);
+		AddStat(cache.TotalAllocationsBytes, sizeBytes);
+		const SizeClass& sizeClass = s_SizeClasses[GetSizeClass(sizeBytes)];
+		switch (sizeClass.Allocator)
 		{
-			std::visit([&dispatcher, &markAlloc](auto&& alloc) {
-				dispatcher.Dispatch(markAlloc.HigherBound, [&alloc](U64 sizeBytes) -> void* { return alloc->Alloc(sizeBytes); });
-			}, markAlloc.Allocator);
-			if (dispatcher.GetAddress() != nullptr) break;
+		case SizeClassAllocator::Pool:
+			return AllocFromPool(cache, sizeClass.PoolIndex);
+		case SizeClassAllocator::Buddy:
+		{
+			// Buddy allocator may run out of memory, then free list allocator takes over.
+			std::unique_lock lock(s_BuddyMutex);
+			if (void* address = s_BuddyAllocator->Alloc(sizeBytes)) return address;
+			lock.unlock();
+			std::lock_guard freelistLock(s_FreelistMutex);
+			return s_FreelistAllocator->Alloc(sizeBytes);
+		}
+		case SizeClassAllocator::Freelist:
+		{
+			std::lock_guard lock(s_FreelistMutex);
+			return s_FreelistAllocator->Alloc(sizeBytes);
 		}
-		void* address = dispatcher.GetAddress();
-		return address;
+		}
+		return nullptr;
 	}
 	
 	void MemoryManager::Dealloc(void* memory)
 	{
-		s_Stats.IsIncomplete = true;
-		s_Stats.TotalUnsizedDeallocations++;
+		ThreadCache& cache = GetThreadCache();
+		AddStat(cache.TotalUnsizedDeallocations, 1);
 		if (memory == nullptr) return;
-		if (s_IsPendingProbe) ProbeAll();
-		MarkedInterval* interval = GetContainingInterval(memory);
-		DeallocationDispatcher dispatcher(*interval, memory);
-		for (auto&& markAlloc : s_Allocators)
-		{
-			std::visit([&dispatcher, &markAlloc](auto&& alloc) {
-				dispatcher.Dispatch(markAlloc.Mark, [&alloc](void* address) { return alloc->Dealloc(address); });
-			}, markAlloc.Allocator);
-		}
+		U8 allocatorIndex = s_PageMap.Get(memory);
+		ENGINE_CORE_ASSERT(allocatorIndex != PageMap::NULL_VALUE, "Memory was not allocated by memory manager.")
+		std::visit([&cache, memory](auto&& alloc) {
+			using Allocator = std::remove_pointer_t<std::decay_t<decltype(alloc)>>;
+			if constexpr (std::is_same_v<Allocator, PoolAllocator>)
+			{
+				DeallocToPool(cache, static_cast<U32>(std::countr_zero(alloc->GetBaseTypeSize())), memory);
+			}
+			else
+			{
+				std::lock_guard lock(std::is_same_v<Allocator, BuddyAllocator> ? s_BuddyMutex : s_FreelistMutex);
+				alloc->Dealloc(memory);
+			}
+		}, s_Allocators[allocatorIndex].Allocator);
 	}
 
 	void MemoryManager::Dealloc(void* memory, U64 sizeBytes)
 	{
-		s_Stats.TotalDeallocations++;
-		s_Stats.TotalDeallocationsBytes += sizeBytes;
+		ThreadCache& cache = GetThreadCache();
+		AddStat(cache.TotalDeallocations, 1);
+		AddStat(cache.TotalDeallocationsBytes, sizeBytes);
 		if (memory == nullptr) return;
-		DeallocationSizeAwareDispatcher dispatcher(memory, sizeBytes);
-		for (auto&& markAlloc : s_Allocators)
+		const SizeClass& sizeClass = s_SizeClasses[GetSizeClass(sizeBytes)];
+		switch (sizeClass.Allocator)
 		{
-			std::visit([&dispatcher, &markAlloc](auto&& alloc) {
-				dispatcher.Dispatch(markAlloc.HigherBound, [&alloc](void* address, U64 sizeBytes) -> void { return alloc->Dealloc(address, sizeBytes); });
-			}, markAlloc.Allocator);
-			if (dispatcher.HasDispatchedAddress()) break;
+		case SizeClassAllocator::Pool:
+			DeallocToPool(cache, sizeClass.PoolIndex, memory);
+			return;
+		case SizeClassAllocator::Buddy:
+		{
+			std::lock_guard lock(s_BuddyMutex);
+			s_BuddyAllocator->Dealloc(memory, sizeBytes);
+			return;
+		}
+		case SizeClassAllocator::Freelist:
+		{
+			std::lock_guard lock(s_FreelistMutex);
+			s_FreelistAllocator->Dealloc(memory);
+			return;
+		}
 		}
 	}
 
+	MemoryManager::ThreadCache& MemoryManager::GetThreadCache()
+	{
+		thread_local ThreadCache cache;
+		return cache;
+	}
+
+	void* MemoryManager::AllocFromPool(ThreadCache& cache, U32 poolIndex)
+	{
+		ThreadCache::Magazine& magazine = cache.Magazines[poolIndex];
+		if (magazine.Count == 0)
+		{
+			// Take half of the magazine at once, so that pool is locked once per several allocations.
+			std::lock_guard lock(s_PoolMutexes[poolIndex]);
+			PoolAllocator* pool = s_Pools[poolIndex];
+			while (magazine.Count < MAGAZINE_CAPACITY / 2) magazine.Blocks[magazine.Count++] = pool->Alloc();
+		}
+		return magazine.Blocks[--magazine.Count];
+	}
+
+	void MemoryManager::DeallocToPool(ThreadCache& cache, U32 poolIndex, void* memory)
+	{
+		ThreadCache::Magazine& magazine = cache.Magazines[poolIndex];
+		if (magazine.Count == MAGAZINE_CAPACITY)
+		{
+			std::lock_guard lock(s_PoolMutexes[poolIndex]);
+			PoolAllocator* pool = s_Pools[poolIndex];
+			while (magazine.Count > MAGAZINE_CAPACITY / 2) pool->Dealloc(magazine.Blocks[--magazine.Count]);
+		}
+		magazine.Blocks[magazine.Count++] = memory;
+	}
+
+	void MemoryManager::AddStats(MemoryManagerStats& stats, const ThreadCache& cache)
+	{
+		stats.TotalAllocations += static_cast<U32>(cache.TotalAllocations.load(std::memory_order_relaxed));
+		stats.TotalAllocationsBytes += cache.TotalAllocationsBytes.load(std::memory_order_relaxed);
+		stats.TotalDeallocations += static_cast<U32>(cache.TotalDeallocations.load(std::memory_order_relaxed));
+		stats.TotalDeallocationsBytes += cache.TotalDeallocationsBytes.load(std::memory_order_relaxed);
+		stats.TotalUnsizedDeallocations += static_cast<U32>(cache.TotalUnsizedDeallocations.load(std::memory_order_relaxed));
+		stats.IsIncomplete = stats.TotalUnsizedDeallocations != 0;
+	}
+
+	MemoryManager::MemoryManagerStats MemoryManager::GetStats()
+	{
+		std::lock_guard lock(s_ThreadCachesMutex);
+		MemoryManagerStats stats = s_FinishedThreadsStats;
+		for (const ThreadCache* cache : s_ThreadCaches) AddStats(stats, *cache);
+		return stats;
+	}
+
 	Ref<MemoryManager::ManagedPoolAllocator> MemoryManager::GetPoolAllocatorRef(U64 typeSizeBytes)
 	{
 		auto newPool = CreateRef<ManagedPoolAllocator>(typeSizeBytes);
@@ -127,9 +268,16 @@ namespace Engine
 		return *GetPoolAllocatorRef(typeSizeBytes);
 	}
 
+	std::pmr::memory_resource* MemoryManager::GetMemoryResource()
+	{
+		static MemoryManagerResource resource;
+		return &resource;
+	}
+
 	void MemoryManager::PrintStats()
 	{
 		// Note: imgui leaks memory >:(.
+		MemoryManagerStats stats = GetStats();
 		ENGINE_CORE_INFO("Memory manager stats:");
 		ENGINE_CORE_TRACE(R""""(
 			Allocations: {} ({} bytes)
@@ -140,13 +288,13 @@ namespace Engine
 			Not complete: {}
 			Memory leak: {} bytes, is relevant: {}
 			)"""",
-			s_Stats.TotalAllocations, s_Stats.TotalAllocationsBytes,
-			s_Stats.TotalDeallocations, s_Stats.TotalDeallocationsBytes,
-			s_Stats.TotalUnsizedDeallocations,
-			s_Stats.TotalDeallocations + s_Stats.TotalUnsizedDeallocations,
-			s_Stats.TotalAllocations - (s_Stats.TotalDeallocations + s_Stats.TotalUnsizedDeallocations),
-			s_Stats.IsIncomplete,
-			s_Stats.GetLeakedMemory(), !s_Stats.IsIncomplete
+			stats.TotalAllocations, stats.TotalAllocationsBytes,
+			stats.TotalDeallocations, stats.TotalDeallocationsBytes,
+			stats.TotalUnsizedDeallocations,
+			stats.TotalDeallocations + stats.TotalUnsizedDeallocations,
+			stats.TotalAllocations - (stats.TotalDeallocations + stats.TotalUnsizedDeallocations),
+			stats.IsIncomplete,
+			stats.GetLeakedMemory(), !stats.IsIncomplete
 		);
 		
 	}
@@ -173,95 +321,10 @@ namespace Engine
 		}
 	}
 
-	void MemoryManager::ProbeAll()
-	{
-		// Best oop solid practices right here.
-		std::vector<MemoryInterval> coveredIntervals{};
-		std::vector<MarkedInterval> markedIntervals{};
-
-		for (auto&& markAlloc : s_Allocators)
-		{
-			std::visit([&markAlloc, &coveredIntervals, &markedIntervals](auto&& alloc) {
-				PerformProbeTask(alloc, markAlloc.Mark, coveredIntervals, markedIntervals);
-			}, markAlloc.Allocator);
-		}
-
-		std::sort(markedIntervals.begin(), markedIntervals.end(), [](auto& a, auto& b) { return a.Interval.Begin < b.Interval.Begin; });
-		s_MarkedIntervals = MergeIntervals(markedIntervals);	
-
-		s_IsPendingProbe = false;
-	}
-
-	std::vector<MemoryInterval> MemoryManager::CarveIntervals(const std::vector<MemoryInterval>& from,
-		const std::vector<MemoryInterval>& what)
-	{
-		std::vector<MemoryInterval> result;
-		// All intervals in `what` contained in intervals `from`.
-		for (const auto& f : from)
-		{
-			MemoryInterval testInterval = f;
-			for (const auto& w : what)
-			{
-				if (w.Begin == testInterval.Begin)
-				{
-					testInterval = { w.End, testInterval.End };
-					continue;
-				}
-				// If intervals overlap.
-				if (w.Begin > testInterval.Begin && w.End < testInterval.End)
-				{
-					result.emplace_back(testInterval.Begin, w.Begin);
-					testInterval = { w.End, testInterval.End };
-				}
-			}
-			result.emplace_back(testInterval);
-		}
-		return result;
-	}
-	std::vector<MarkedInterval> MemoryManager::MarkIntervals(const std::vector<MemoryInterval>& intervals, U64 mark)
-	{
-		std::vector<MarkedInterval> result;
-		result.reserve(intervals.size());
-		for (auto& i : intervals)
-		{
-			result.emplace_back(i, mark);
-		}
-		return result;
-	}
-	std::vector<MarkedInterval> MemoryManager::MergeIntervals(const std::vector<MarkedInterval>& intervals)
-	{
-		if (intervals.size() == 0) return intervals;
-
-		std::vector<MarkedInterval> result;
-		U64 begin = intervals.front().Interval.Begin;
-		U64 end = intervals.front().Interval.End;
-		U64 currentMark = intervals.front().Mark;
-		for (U32 i = 1; i < intervals.size(); i++)
-		{
-			if (intervals[i].Mark != currentMark)
-			{
-				end = intervals[i].Interval.Begin;
-				result.push_back({ { begin, end }, currentMark });
-				currentMark = intervals[i].Mark;
-				begin = intervals[i].Interval.Begin;
-			}
-			end = intervals[i].Interval.End;
-		}
-		result.push_back({ { begin, end }, currentMark });
-		return result;
-	}
-
-	MarkedInterval* MemoryManager::GetContainingInterval(void* address)
+	void MemoryManager::OnAllocatorExpand(U64 userData, void* memory, U64 sizeBytes)
 	{
-		U64 addressU64 = reinterpret_cast<U64>(address);
-
-		for (auto& mi : s_MarkedIntervals)
-		{
-			if (addressU64 >= mi.Interval.Begin && addressU64 < mi.Interval.End)
-			{
-				return &mi;
-			}
-		}
-		return nullptr;
+		U64 begin = reinterpret_cast<U64>(memory);
+		std::lock_guard lock(s_PageMapMutex);
+		s_PageMap.Set(begin, begin + sizeBytes, static_cast<U8>(userData));
 	}
-}
\ No newline at end of file
+}
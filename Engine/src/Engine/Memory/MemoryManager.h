@@ -3,11 +3,17 @@
 #include "BuddyAllocator.h"
 #include "DequeAllocator.h"
 #include "FreelistRedBlackTreeAllocator.h"
+#include "PageMap.h"
 #include "PoolAllocator.h"
 #include "StackAllocator.h"
 #include "Engine/Core/Core.h"
 #include "Engine/Core/Log.h"
 
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory_resource>
+#include <mutex>
 #include <variant>
 
 namespace Engine
@@ -19,79 +25,17 @@ namespace Engine
 	static U64 MEDIUM_POOL_SIZE = 128_B;
 	static U64 BIG_POOL_SIZE = 512_B;
 	static U64 BUDDY_DEFAULT_SIZE_BYTES = 16_MiB;
-
-	struct MemoryInterval
-	{
-		U64 Begin;
-		U64 End;
-	};
-
-	struct MarkedInterval
-	{
-		MemoryInterval Interval;
-		U64 Mark;
-		U64 TargetCount{};
-	};
-
-	class DeallocationDispatcher
-	{
-	public:
-		DeallocationDispatcher(MarkedInterval& interval, void* address) : m_Interval(interval), m_Address(address)
-		{ }
-
-		template <typename Fn>
-		void Dispatch(U64 mark, Fn func)
-		{
-			if (m_Interval.Mark == mark) func(m_Address);
-		}
-	private:
-		MarkedInterval m_Interval;
-		void* m_Address;
-	};
-
-	class DeallocationSizeAwareDispatcher
-	{
-	public:
-		DeallocationSizeAwareDispatcher(void* address, U64 sizeBytes): m_SizeBytes(sizeBytes), m_Address(address), m_Dispatched(false)
-		{ }
-
-		template <typename Fn>
-		void Dispatch(U64 sizeBytes, Fn func)
-		{
-			if (m_SizeBytes <= sizeBytes)
-			{
-				func(m_Address, m_SizeBytes);
-				m_Dispatched = true;
-			}
-		}
-
-		bool HasDispatchedAddress() const { return m_Dispatched; }
-
-	private:
-		U64 m_SizeBytes;
-		void* m_Address;
-		bool m_Dispatched;
-	};
-
-	class AllocationDispatcher
-	{
-	public:
-		AllocationDispatcher(U64 sizeBytes) : m_SizeBytes(sizeBytes), m_Address(nullptr)
-		{ }
-
-		template <typename Fn>
-		void Dispatch(U64 sizeBytes, Fn func)
-		{
-			if (m_SizeBytes <= sizeBytes) m_Address = func(m_SizeBytes);
-		}
-
-		void* GetAddress() const { return m_Address; }
-
-	private:
-		U64 m_SizeBytes;
-		void* m_Address;
-	};
-
+	// Allocations up to `1 << POOL_MAX_SIZE_CLASS` bytes go to pools,
+	// up to `1 << BUDDY_MAX_SIZE_CLASS` bytes to buddy allocator, and the rest to free list allocator.
+	static constexpr U32 POOL_MIN_SIZE_CLASS = 3;
+	static constexpr U32 POOL_MAX_SIZE_CLASS = 10;
+	static constexpr U32 BUDDY_MAX_SIZE_CLASS = 27;
+	// Blocks of each pool size class, a thread keeps for itself (half of it is moved from / to the pool at once).
+	static constexpr U32 MAGAZINE_CAPACITY = 64;
+
+	// Thread-safe: pool size classes are served from per-thread magazines, that are refilled from
+	// (and returned to) the shared pools in batches under per-pool locks, other allocators are locked as a whole.
+	// Managed pools (`GetPoolAllocator`) are not thread-safe.
 	class MemoryManager
 	{
 		template<typename ...Ts>
@@ -153,64 +97,90 @@ namespace Engine
 		template <typename T>
 		static ManagedPoolAllocator& GetPoolAllocator() { return GetPoolAllocator(sizeof(T)); }
 
+		// Resource for `std::pmr` containers, that routes to `Alloc / Dealloc` (thread-safe).
+		static std::pmr::memory_resource* GetMemoryResource();
+
+		// Sum of the stats of every thread.
+		static MemoryManagerStats GetStats();
 		// Prints the current allocation/deallocation stats.
 		static void PrintStats();
 		static void PrintPoolsStats();
 
 	private:
-		static void ProbeAll();
-		static MarkedInterval* GetContainingInterval(void* address);
-
-		// TODO: custom containters.
-		static std::vector<MemoryInterval> CarveIntervals(const std::vector<MemoryInterval>& from, const std::vector<MemoryInterval>& what);
-		static std::vector<MarkedInterval> MarkIntervals(const std::vector<MemoryInterval>& intervals, U64 mark);
-		static std::vector<MarkedInterval> MergeIntervals(const std::vector<MarkedInterval>& intervals);
-
-		template <typename Allocator>
-		static std::vector<MemoryInterval> Probe(Allocator* alloc)
+		enum class SizeClassAllocator : U8 { Pool, Buddy, Freelist };
+		struct SizeClass
 		{
-			std::vector<MemoryInterval> result;
-			std::vector<U64> memoryBounds = alloc->GetMemoryBounds();
+			SizeClassAllocator Allocator{SizeClassAllocator::Freelist};
+			// Size class of the pool (index in `s_Pools`).
+			U32 PoolIndex{0};
+		};
 
-			for (U64 memIndex = 0; memIndex < memoryBounds.size(); memIndex += 2)
+		// Magazines of pool blocks and allocation stats of a thread.
+		struct ThreadCache
+		{
+			struct Magazine
 			{
-				auto begin = memoryBounds[memIndex];
-				auto end = memoryBounds[memIndex + 1];
-				result.emplace_back(begin, end);
-				//ENGINE_INFO("{} from {:x} to {:x} ({} bytes)", alloc->GetDebugName(), begin, end, end - begin);
-			}
-			return result;
-		}
+				void* Blocks[MAGAZINE_CAPACITY];
+				U32 Count{0};
+			};
+			ThreadCache();
+			~ThreadCache();
+			// Returns all blocks to the pools.
+			void Flush();
+
+			Magazine Magazines[POOL_MAX_SIZE_CLASS + 1];
+			// Written by the owning thread only (no read-modify-write), read by `GetStats`.
+			std::atomic<U64> TotalAllocations{0};
+			std::atomic<U64> TotalAllocationsBytes{0};
+			std::atomic<U64> TotalDeallocations{0};
+			std::atomic<U64> TotalDeallocationsBytes{0};
+			std::atomic<U64> TotalUnsizedDeallocations{0};
+		};
+		// Size class is the power of 2, allocation is rounded up to.
+		static U32 GetSizeClass(U64 sizeBytes) { return sizeBytes <= 1 ? 0 : static_cast<U32>(std::bit_width(sizeBytes - 1)); }
 
-		template <typename Allocator>
-		static void PerformProbeTask(Allocator* alloc, U64 allocatorMark,
-			std::vector<MemoryInterval>& coveredIntervals,
-			std::vector<MarkedInterval>& markedIntervals)
+		// Keeps page map up to date, `userData` is the index of allocator in `s_Allocators`.
+		static void OnAllocatorExpand(U64 userData, void* memory, U64 sizeBytes);
+
+		static ThreadCache& GetThreadCache();
+		static void* AllocFromPool(ThreadCache& cache, U32 poolIndex);
+		static void DeallocToPool(ThreadCache& cache, U32 poolIndex, void* memory);
+		static void AddStat(std::atomic<U64>& stat, U64 value)
 		{
-			auto coveredLocal = Probe(alloc);
-			coveredIntervals.insert(coveredIntervals.end(), coveredLocal.begin(), coveredLocal.end());
-			auto markedLocal = MarkIntervals(coveredLocal, allocatorMark);
-			markedIntervals.insert(markedIntervals.end(), markedLocal.begin(), markedLocal.end());
+			stat.store(stat.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
 		}
-													  
+		static void AddStats(MemoryManagerStats& stats, const ThreadCache& cache);
+
 	private:
 		
 		struct MarkedAllocator
 		{
 			AllocatorPolyType<PoolAllocator*, BuddyAllocator*, FreelistRedBlackAllocator*> Allocator;
-			U64 Mark{};
 			U64 HigherBound{};
 		};
 
 		static std::vector<MarkedAllocator> s_Allocators;
 
-		static std::vector<MarkedInterval> s_MarkedIntervals;
+		// Allocator for every size class, so that allocation is routed without walking `s_Allocators`.
+		static std::array<SizeClass, 65> s_SizeClasses;
+		static std::array<PoolAllocator*, POOL_MAX_SIZE_CLASS + 1> s_Pools;
+		static BuddyAllocator* s_BuddyAllocator;
+		static FreelistRedBlackAllocator* s_FreelistAllocator;
+		static std::array<std::mutex, POOL_MAX_SIZE_CLASS + 1> s_PoolMutexes;
+		static std::mutex s_BuddyMutex;
+		static std::mutex s_FreelistMutex;
 
 		static std::vector<Ref<ManagedPoolAllocator>> s_ManagedPools;
 
-		static bool s_IsPendingProbe;
+		// Maps memory of every allocator to its index in `s_Allocators` (for unsized deallocation).
+		static PageMap s_PageMap;
+		static std::mutex s_PageMapMutex;
 
-		static MemoryManagerStats s_Stats;
+		// Caches of alive threads, and the stats of finished ones.
+		static std::vector<ThreadCache*> s_ThreadCaches;
+		static MemoryManagerStats s_FinishedThreadsStats;
+		static std::mutex s_ThreadCachesMutex;
+		static bool s_IsInitialized;
 	};
 
 	template <typename T, typename ... Args>
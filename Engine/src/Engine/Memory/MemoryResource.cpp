@@ -0,0 +1,97 @@
+#include "enginepch.h"
+
+#include "MemoryResource.h"
+#include "MemoryManager.h"
+#include "MemoryUtils.h"
+#include "Engine/Core/Core.h"
+
+namespace Engine
+{
+	void* MemoryManagerResource::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		if (alignment <= alignof(std::max_align_t)) return MemoryManager::Alloc(bytes);
+
+		// Over-aligned: allocate extra bytes, and store the address of the block right before the aligned memory.
+		ENGINE_CORE_ASSERT(alignment <= std::numeric_limits<U16>::max(), "Alignment is too big.")
+		U8* memory = static_cast<U8*>(MemoryManager::Alloc(bytes + alignment + sizeof(void*)));
+		U8* alignedMemory = MemoryUtils::AlignPointer(memory + sizeof(void*), static_cast<U16>(alignment));
+		reinterpret_cast<void**>(alignedMemory)[-1] = memory;
+		return alignedMemory;
+	}
+
+	void MemoryManagerResource::do_deallocate(void* memory, std::size_t bytes, std::size_t alignment)
+	{
+		if (alignment <= alignof(std::max_align_t))
+		{
+			MemoryManager::Dealloc(memory, bytes);
+			return;
+		}
+		MemoryManager::Dealloc(static_cast<void**>(memory)[-1], bytes + alignment + sizeof(void*));
+	}
+
+	PoolMemoryResource::PoolMemoryResource(PoolAllocator& allocator, std::pmr::memory_resource* upstream)
+		: m_Allocator(allocator), m_Upstream(upstream ? upstream : MemoryManager::GetMemoryResource())
+	{}
+
+	void* PoolMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		if (!Fits(bytes, alignment)) return m_Upstream->allocate(bytes, alignment);
+		return m_Allocator.Alloc();
+	}
+
+	void PoolMemoryResource::do_deallocate(void* memory, std::size_t bytes, std::size_t alignment)
+	{
+		if (!Fits(bytes, alignment)) m_Upstream->deallocate(memory, bytes, alignment);
+		else m_Allocator.Dealloc(memory);
+	}
+
+	bool PoolMemoryResource::Fits(std::size_t bytes, std::size_t alignment) const
+	{
+		// Pool memory regions are aligned to `MEMORY_REGION_ALIGNMENT`, so elements are aligned to the divisors of element size.
+		const U64 elementSize = m_Allocator.GetBaseTypeSize();
+		return bytes <= elementSize && alignment <= MEMORY_REGION_ALIGNMENT && elementSize % alignment == 0;
+	}
+
+	StackMemoryResource::StackMemoryResource(StackAllocator& allocator, std::pmr::memory_resource* upstream)
+		: m_Allocator(allocator), m_Upstream(upstream ? upstream : MemoryManager::GetMemoryResource())
+	{}
+
+	void* StackMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		ENGINE_CORE_ASSERT(alignment <= std::numeric_limits<U16>::max(), "Alignment is too big.")
+		// Overflow is expected here (it goes upstream), so it is not reported.
+		void* memory = m_Allocator.TryAllocAligned(bytes, static_cast<U16>(alignment));
+		if (memory == nullptr) return m_Upstream->allocate(bytes, alignment);
+		return memory;
+	}
+
+	void StackMemoryResource::do_deallocate(void* memory, std::size_t bytes, std::size_t alignment)
+	{
+		if (!m_Allocator.Belongs(memory)) m_Upstream->deallocate(memory, bytes, alignment);
+	}
+
+	void* BuddyMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		// Blocks are power of 2 sized, and aligned to their size (up to `MEMORY_REGION_ALIGNMENT`).
+		ENGINE_CORE_ASSERT(alignment <= MEMORY_REGION_ALIGNMENT, "Alignment is too big.")
+		return m_Allocator.Alloc(std::max(bytes, alignment));
+	}
+
+	void BuddyMemoryResource::do_deallocate(void* memory, [[maybe_unused]] std::size_t bytes, [[maybe_unused]] std::size_t alignment)
+	{
+		// Level of the block is known to allocator (sized deallocation expects sizes of at least a leaf).
+		m_Allocator.Dealloc(memory);
+	}
+
+	void* FreelistMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		// Alignment offset is stored in a single byte.
+		ENGINE_CORE_ASSERT(alignment < MEMORY_REGION_ALIGNMENT, "Alignment is too big.")
+		return m_Allocator.AllocAligned(bytes, static_cast<U16>(alignment));
+	}
+
+	void FreelistMemoryResource::do_deallocate(void* memory, [[maybe_unused]] std::size_t bytes, [[maybe_unused]] std::size_t alignment)
+	{
+		m_Allocator.Dealloc(memory);
+	}
+}
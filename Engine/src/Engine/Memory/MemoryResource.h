@@ -0,0 +1,86 @@
+#pragma once
+
+#include "BuddyAllocator.h"
+#include "FreelistRedBlackTreeAllocator.h"
+#include "PoolAllocator.h"
+#include "StackAllocator.h"
+#include "Engine/Core/Types.h"
+
+#include <memory_resource>
+
+namespace Engine
+{
+	using namespace Types;
+	// `std::pmr::memory_resource` adapters of engine allocators, so that `std::pmr` containers can be routed to them.
+	// Except for `MemoryManagerResource`, resources are not thread-safe (as the allocators they wrap),
+	// and do not own the allocator, that shall outlive every container using it.
+
+	// Routes to `MemoryManager` (so that containers are part of its stats), thread-safe.
+	class MemoryManagerResource : public std::pmr::memory_resource
+	{
+	protected:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+
+	// Serves requests that fit pool element (both size and alignment), the rest goes to `upstream`.
+	// Suits node based containers (`std::pmr::list`, `std::pmr::map`, etc.).
+	class PoolMemoryResource : public std::pmr::memory_resource
+	{
+	public:
+		explicit PoolMemoryResource(PoolAllocator& allocator, std::pmr::memory_resource* upstream = nullptr);
+		PoolAllocator& GetAllocator() const { return m_Allocator; }
+	protected:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	private:
+		bool Fits(std::size_t bytes, std::size_t alignment) const;
+	private:
+		PoolAllocator& m_Allocator;
+		std::pmr::memory_resource* m_Upstream;
+	};
+
+	// Deallocation is no-op (memory is reclaimed by `StackAllocator::FreeToMarker / Clear`),
+	// requests that do not fit into stack go to `upstream`.
+	class StackMemoryResource : public std::pmr::memory_resource
+	{
+	public:
+		explicit StackMemoryResource(StackAllocator& allocator, std::pmr::memory_resource* upstream = nullptr);
+		StackAllocator& GetAllocator() const { return m_Allocator; }
+	protected:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	private:
+		StackAllocator& m_Allocator;
+		std::pmr::memory_resource* m_Upstream;
+	};
+
+	class BuddyMemoryResource : public std::pmr::memory_resource
+	{
+	public:
+		explicit BuddyMemoryResource(BuddyAllocator& allocator) : m_Allocator(allocator) {}
+		BuddyAllocator& GetAllocator() const { return m_Allocator; }
+	protected:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	private:
+		BuddyAllocator& m_Allocator;
+	};
+
+	class FreelistMemoryResource : public std::pmr::memory_resource
+	{
+	public:
+		explicit FreelistMemoryResource(FreelistRedBlackAllocator& allocator) : m_Allocator(allocator) {}
+		FreelistRedBlackAllocator& GetAllocator() const { return m_Allocator; }
+	protected:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	private:
+		FreelistRedBlackAllocator& m_Allocator;
+	};
+}
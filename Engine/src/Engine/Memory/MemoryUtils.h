@@ -6,6 +6,13 @@
 namespace Engine
 {
 	using namespace Types;
+	// Alignment of memory regions, that allocators request from the system
+	// (so that regions of different allocators never share a page of `PageMap`).
+	static constexpr U16 MEMORY_REGION_ALIGNMENT = 256;
+
+	// Called by allocators with every memory region they request from the system on expansion.
+	using MemoryExpandCallbackFn = void (*)(U64 userData, void* memory, U64 sizeBytes);
+
 	class MemoryUtils
 	{
 	public:
@@ -0,0 +1,48 @@
+#include "enginepch.h"
+
+#include "PageMap.h"
+#include "MemoryUtils.h"
+#include "Engine/Core/Core.h"
+
+#include <cstring>
+
+namespace Engine
+{
+	PageMap::~PageMap()
+	{
+		Clear();
+	}
+
+	void PageMap::Set(U64 begin, U64 end, U8 value)
+	{
+		ENGINE_CORE_ASSERT(begin < end && (end - 1) >> ADDRESS_BITS == 0, "Invalid memory region.")
+		U64 lastPage = (end - 1) >> PAGE_SIZE_LOG;
+		for (U64 page = begin >> PAGE_SIZE_LOG; page <= lastPage; page++)
+		{
+			Node*& node = m_Root[page >> (NODE_BITS + LEAF_BITS)];
+			if (node == nullptr)
+			{
+				node = static_cast<Node*>(MemoryUtils::AllocAligned(sizeof(Node)));
+				std::memset(node, 0, sizeof(Node));
+			}
+			Leaf*& leaf = node->Leaves[(page >> LEAF_BITS) & ((U64(1) << NODE_BITS) - 1)];
+			if (leaf == nullptr)
+			{
+				leaf = static_cast<Leaf*>(MemoryUtils::AllocAligned(sizeof(Leaf)));
+				std::memset(leaf, NULL_VALUE, sizeof(Leaf));
+			}
+			leaf->Values[page & ((U64(1) << LEAF_BITS) - 1)] = value;
+		}
+	}
+
+	void PageMap::Clear()
+	{
+		for (Node*& node : m_Root)
+		{
+			if (node == nullptr) continue;
+			for (Leaf* leaf : node->Leaves) MemoryUtils::FreeAligned(leaf);
+			MemoryUtils::FreeAligned(node);
+			node = nullptr;
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Engine/Core/Types.h"
+
+namespace Engine
+{
+	using namespace Types;
+	// Radix tree (three levels, like tcmalloc's page map) from memory page to a small value (allocator index),
+	// lookup takes three dependent loads regardless of how many memory regions were registered.
+	// Regions are expected to be aligned to the page size, so that no two regions share a page.
+	class PageMap
+	{
+	public:
+		static constexpr U8 NULL_VALUE = 0xFF;
+		static constexpr U32 PAGE_SIZE_LOG = 8;
+	public:
+		PageMap() = default;
+		PageMap(const PageMap&) = delete;
+		PageMap& operator=(const PageMap&) = delete;
+		~PageMap();
+
+		// Maps every page that intersects [begin, end) to `value`.
+		void Set(U64 begin, U64 end, U8 value);
+		// Returns `NULL_VALUE` for pages that were never set.
+		U8 Get(const void* address) const;
+
+		// Frees all nodes.
+		void Clear();
+	private:
+		static constexpr U32 ADDRESS_BITS = 48;
+		static constexpr U32 LEAF_BITS = 13;
+		static constexpr U32 NODE_BITS = 13;
+		static constexpr U32 ROOT_BITS = ADDRESS_BITS - PAGE_SIZE_LOG - NODE_BITS - LEAF_BITS;
+
+		struct Leaf
+		{
+			U8 Values[U64(1) << LEAF_BITS];
+		};
+		struct Node
+		{
+			Leaf* Leaves[U64(1) << NODE_BITS];
+		};
+	private:
+		// Nodes are allocated directly from the system, since page map is used by memory manager itself.
+		Node* m_Root[U64(1) << ROOT_BITS]{};
+	};
+
+	inline U8 PageMap::Get(const void* address) const
+	{
+		U64 page = reinterpret_cast<U64>(address) >> PAGE_SIZE_LOG;
+		if (page >> (ROOT_BITS + NODE_BITS + LEAF_BITS)) return NULL_VALUE;
+		const Node* node = m_Root[page >> (NODE_BITS + LEAF_BITS)];
+		if (node == nullptr) return NULL_VALUE;
+		const Leaf* leaf = node->Leaves[(page >> LEAF_BITS) & ((U64(1) << NODE_BITS) - 1)];
+		if (leaf == nullptr) return NULL_VALUE;
+		return leaf->Values[page & ((U64(1) << LEAF_BITS) - 1)];
+	}
+}
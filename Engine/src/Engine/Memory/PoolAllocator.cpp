@@ -20,7 +20,7 @@ namespace Engine
             typeSizeBytes = sizeof(void*);
             m_TypeSizeBytes = sizeof(void*);
         }
-        void* poolMemory = MemoryUtils::AllocAligned(typeSizeBytes * count);
+        void* poolMemory = MemoryUtils::AllocAligned(typeSizeBytes * count, MEMORY_REGION_ALIGNMENT);
         m_PoolMemory = static_cast<U8*>(poolMemory);
         m_FreePoolElement = static_cast<PoolElement*>(poolMemory);
 
@@ -68,17 +68,18 @@ namespace Engine
                              m_TotalPoolElements * m_TypeSizeBytes);
             ENGINE_CORE_WARN(
                 "{}: iterators/pointers are invalidated due to continuality of pool memory, you can disable this constraint.", m_DebugName);
-            void* newMemory = MemoryUtils::AllocAligned(m_TotalPoolElements * m_TypeSizeBytes);
+            void* newMemory = MemoryUtils::AllocAligned(m_TotalPoolElements * m_TypeSizeBytes, MEMORY_REGION_ALIGNMENT);
             MemoryUtils::Copy(newMemory, m_PoolMemory, oldElementsCount * m_TypeSizeBytes);
             MemoryUtils::FreeAligned(m_PoolMemory);
             m_PoolMemory = static_cast<U8*>(newMemory);
             U8* offset = m_PoolMemory + oldElementsCount * m_TypeSizeBytes;
             InitializePool(offset, oldElementsCount);
+            m_CallbackFn(m_CallbackUserData, m_PoolMemory, m_TotalPoolElements * m_TypeSizeBytes);
             return offset;
         }
 
         // Allocate additional memory (according to config).
-        void* poolExtension = MemoryUtils::AllocAligned(m_TypeSizeBytes * m_IncrementElements);
+        void* poolExtension = MemoryUtils::AllocAligned(m_TypeSizeBytes * m_IncrementElements, MEMORY_REGION_ALIGNMENT);
         ENGINE_CORE_INFO("{}: requesting {} bytes of memory from the system.", m_DebugName,
                          m_TypeSizeBytes * m_IncrementElements);
         m_AdditionalAllocations.push_back(poolExtension);
@@ -86,7 +87,7 @@ namespace Engine
         InitializePool(poolExtension, m_IncrementElements);
 
         // Callback is defined in memory manager.
-        m_CallbackFn();
+        m_CallbackFn(m_CallbackUserData, poolExtension, m_TypeSizeBytes * m_IncrementElements);
 
         return poolExtension;
     }
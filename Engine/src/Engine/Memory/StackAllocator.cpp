@@ -26,17 +26,23 @@ namespace Engine
 	}
 
 	void* StackAllocator::AllocAligned(U64 sizeBytes, U16 alignment)
+	{
+		void* memory = TryAllocAligned(sizeBytes, alignment);
+		if (memory == nullptr)
+		{
+			ENGINE_CORE_ERROR("Failed to allocate {} bytes: not enough memory ({} bytes)", sizeBytes + alignment - 1, m_StackSize - m_Marker);
+		}
+		return memory;
+	}
+
+	void* StackAllocator::TryAllocAligned(U64 sizeBytes, U16 alignment)
 	{
 		U16 mask = alignment - 1;
 		U64 actualBytes = sizeBytes + mask;
 
 		U64 newMarker = m_Marker + actualBytes;
 		// If requested block cannot be allocated, return nullptr (alloc, new (std::nothrow) style).
-		if (newMarker > m_StackSize) 
-		{
-			ENGINE_CORE_ERROR("Failed to allocate {} bytes: not enough memory ({} bytes)", actualBytes, m_StackSize - m_Marker);
-			return nullptr;
-		}
+		if (newMarker > m_StackSize) return nullptr;
 
 		// Align memory address.
 		U8* address = MemoryUtils::AlignPointer(m_StackMemory + m_Marker, alignment);
@@ -58,6 +64,12 @@ namespace Engine
 		m_Marker = 0;
 	}
 
+	bool StackAllocator::Belongs(void* memory) const
+	{
+		U8* address = static_cast<U8*>(memory);
+		return address >= m_StackMemory && address < m_StackMemory + m_StackSize;
+	}
+
 	StackAllocator::~StackAllocator()
 	{
 		MemoryUtils::FreeAligned(m_StackMemory);
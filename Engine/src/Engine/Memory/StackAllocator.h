@@ -15,6 +15,8 @@ namespace Engine
 		void* Alloc(U64 sizeBytes);
 
 		void* AllocAligned(U64 sizeBytes, U16 alignment);
+		// Same as `AllocAligned`, but does not report the lack of memory (for callers that have a fallback).
+		void* TryAllocAligned(U64 sizeBytes, U16 alignment);
 
 		template <typename T>
 		T* Alloc(U64 count = 1) { return static_cast<T*>(Alloc(count * sizeof(T))); }
@@ -33,6 +35,8 @@ namespace Engine
 
 		// Clears the stack (no memory dealoc).
 		void Clear();
+
+		bool Belongs(void* memory) const;
 	private:
 		U8* m_StackMemory;
 
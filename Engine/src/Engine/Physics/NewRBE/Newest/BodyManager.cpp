@@ -7,6 +7,10 @@
 
 namespace Engine::WIP::Physics::Newest
 {
+    BodyManager::BodyManager(std::pmr::memory_resource* resource)
+        : m_Bodies(resource), m_ActiveBodies(resource)
+    {}
+
     void BodyManager::Init(PhysicsSystem* physicsSystem, U32 maxBodyCount)
     {
         m_PhysicsSystem = physicsSystem;
@@ -1,6 +1,9 @@
 ﻿#pragma once
 #include "Collision/Colliders/Collider2D.h"
 #include "Engine/Physics/NewRBE/Newest/RigidBody.h"
+#include "Engine/Memory/MemoryManager.h"
+
+#include <memory_resource>
 
 namespace Engine::WIP::Physics::Newest
 {
@@ -8,7 +11,7 @@ namespace Engine::WIP::Physics::Newest
     
     enum class StartUpBehaviour { SetActive, SetInactive };
 
-    using ActiveBodyIterator = std::vector<RigidBodyId2D>::const_iterator;
+    using ActiveBodyIterator = std::pmr::vector<RigidBodyId2D>::const_iterator;
     
     class BodyManager
     {
@@ -24,6 +27,7 @@ namespace Engine::WIP::Physics::Newest
         };
         using FreeListIndex = U32;
     public:
+        explicit BodyManager(std::pmr::memory_resource* resource = MemoryManager::GetMemoryResource());
         void Init(PhysicsSystem* physicsSystem, U32 maxBodyCount);
         void ShutDown();
         RigidBody2D* CreateBody(const RigidBodyDesc2D& rbDesc);
@@ -33,8 +37,8 @@ namespace Engine::WIP::Physics::Newest
 
         Collider2D* SetCollider(RigidBodyId2D rbId, const ColliderDesc2D& colDef);
 
-        const std::vector<RigidBody2D*>& GetBodies() const { return m_Bodies; }
-        const std::vector<RigidBodyId2D>& GetActiveBodies() const { return m_ActiveBodies; }
+        const std::pmr::vector<RigidBody2D*>& GetBodies() const { return m_Bodies; }
+        const std::pmr::vector<RigidBodyId2D>& GetActiveBodies() const { return m_ActiveBodies; }
         RigidBody2D* GetBody(RigidBodyId2D rbId) const { return m_Bodies[rbId]; }
 
         U32 GetBodyCount() const { return static_cast<U32>(m_Bodies.size()); }
@@ -51,11 +55,11 @@ namespace Engine::WIP::Physics::Newest
     private:
         PhysicsSystem* m_PhysicsSystem{nullptr};
         
-        std::vector<RigidBody2D*> m_Bodies;
+        std::pmr::vector<RigidBody2D*> m_Bodies;
         static constexpr auto FL_INVALID_INDEX = std::numeric_limits<U32>::max();
         FreeListIndex m_FirstFreeRb{FL_INVALID_INDEX};
         
-        std::vector<RigidBodyId2D> m_ActiveBodies;
+        std::pmr::vector<RigidBodyId2D> m_ActiveBodies;
 
         U32 m_MaxBodyCount{0};
         
@@ -4,7 +4,8 @@
 
 namespace Engine::WIP::Physics::Newest
 {
-	BVHTree2D::BVHTree2D()
+	BVHTree2D::BVHTree2D(std::pmr::memory_resource* resource)
+		: m_Nodes(resource)
 	{
 		Clear();
 	}
@@ -5,6 +5,9 @@
 #include <stack>
 
 #include "Engine/Physics/NewRBE/Newest/Collision/CollisionLayer.h"
+#include "Engine/Memory/MemoryManager.h"
+
+#include <memory_resource>
 
 namespace Engine
 {
@@ -51,7 +54,7 @@ namespace Engine::WIP::Physics::Newest
 			F32 SA = std::numeric_limits<F32>::max();
 		};
 	public:
-		BVHTree2D();
+		explicit BVHTree2D(std::pmr::memory_resource* resource = MemoryManager::GetMemoryResource());
 		void SetCollisionLayer(CollisionLayer layer) { m_CollisionLayer = layer; }
 		CollisionLayer GetCollisionLayer() const { return m_CollisionLayer; }
 		void Clear();
@@ -96,7 +99,7 @@ namespace Engine::WIP::Physics::Newest
 		
 		CollisionLayer m_CollisionLayer{};
 		
-		std::vector<BVHNode> m_Nodes;
+		std::pmr::vector<BVHNode> m_Nodes;
 		U32 m_FreeList = BVHNode::NULL_NODE;
 		U32 m_FreeNodesCount = 0;
 		U32 m_TreeRoot = BVHNode::NULL_NODE;
@@ -11,7 +11,9 @@ namespace Engine::WIP::Physics::Newest
         m_PhysicsSystem = physicsSystem;
         m_BroadPhaseLayers = bpLayers;
         m_BodyToBroadPhaseLayerFilter = bpFilter;
-        m_Trees.resize(bpLayers->GetLayersCount());
+        m_Trees.clear();
+        m_Trees.reserve(bpLayers->GetLayersCount());
+        for (U32 i = 0; i < bpLayers->GetLayersCount(); i++) m_Trees.emplace_back(m_MemoryResource);
     }
 
     void BroadPhase2D::RegisterBody(RigidBodyId2D rbId)
@@ -50,9 +52,9 @@ namespace Engine::WIP::Physics::Newest
         m_Trees[broadLayer].Move(body->GetIndexInBroadPhase(), body->GetBounds(), vel);
     }
 
-    std::vector<BroadContactPair> BroadPhase2D::GetPairs(ActiveBodyIterator begin, ActiveBodyIterator end) const
+    FrameVector<BroadContactPair> BroadPhase2D::GetPairs(ActiveBodyIterator begin, ActiveBodyIterator end) const
     {
-        std::vector<BroadContactPair> pairs;
+        FrameVector<BroadContactPair> pairs;
         // TODO: sort bodies by collision layer, and query trees independently.
         const BodyManager& bodyManager = m_PhysicsSystem->GetBodyManager();
         auto& bodies = bodyManager.GetBodies();
@@ -72,7 +74,7 @@ namespace Engine::WIP::Physics::Newest
         return pairs;
     }
 
-    void BroadPhase2D::AddPair(std::vector<BroadContactPair>& pairs, RigidBody2D* first, RigidBody2D* second) const
+    void BroadPhase2D::AddPair(FrameVector<BroadContactPair>& pairs, RigidBody2D* first, RigidBody2D* second) const
     {
         if (first == second) return;
         if (second->IsInActiveBodies() && second->GetId() < first->GetId()) return;
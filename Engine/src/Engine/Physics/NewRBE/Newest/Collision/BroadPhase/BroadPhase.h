@@ -3,6 +3,7 @@
 #include "../../RigidBody.h"
 #include "BVHTree.h"
 #include "Engine/Physics/NewRBE/Newest/BodyManager.h"
+#include "Engine/Memory/FrameAllocator.h"
 
 namespace Engine::WIP::Physics::Newest
 {
@@ -17,16 +18,20 @@ namespace Engine::WIP::Physics::Newest
 	class BroadPhase2D
 	{
 	public:
+		// `resource` is used by trees of each broad phase layer.
+		explicit BroadPhase2D(std::pmr::memory_resource* resource = MemoryManager::GetMemoryResource()) : m_MemoryResource(resource) {}
 		void Init(PhysicsSystem* physicsSystem, Ref<BroadPhaseLayers> bpLayers, Ref<BodyToBroadPhaseLayerFilter> bpFilter);
 		void RegisterBody(RigidBodyId2D rbId);
 		void UnregisterBody(RigidBodyId2D rbId);
 		void MoveBody(RigidBodyId2D rbId, const glm::vec2& vel);
-		std::vector<BroadContactPair> GetPairs(ActiveBodyIterator begin, ActiveBodyIterator end) const;
+		// Pairs are valid for `FRAME_ALLOCATOR_FRAMES` frames.
+		FrameVector<BroadContactPair> GetPairs(ActiveBodyIterator begin, ActiveBodyIterator end) const;
 		const std::vector<BVHTree2D>& GetTrees() const { return m_Trees; }
 	private:
-		void AddPair(std::vector<BroadContactPair>& pairs, RigidBody2D* first, RigidBody2D* second) const;
+		void AddPair(FrameVector<BroadContactPair>& pairs, RigidBody2D* first, RigidBody2D* second) const;
 	private:
 		std::vector<BVHTree2D> m_Trees;
+		std::pmr::memory_resource* m_MemoryResource;
 		PhysicsSystem* m_PhysicsSystem{nullptr};
 		Ref<BroadPhaseLayers> m_BroadPhaseLayers;
 		Ref<BodyToBroadPhaseLayerFilter> m_BodyToBroadPhaseLayerFilter;
@@ -40,7 +40,7 @@ namespace Engine::WIP::Physics::Newest
         m_IslandCount = 0;
     }
 
-    void IslandManager::Finalize(const std::vector<RigidBodyId2D>& activeBodies)
+    void IslandManager::Finalize(std::span<const RigidBodyId2D> activeBodies)
     {
         BuildIslands(activeBodies);
     }
@@ -52,7 +52,7 @@ namespace Engine::WIP::Physics::Newest
         return linkedTo;
     }
 
-    void IslandManager::BuildIslands(const std::vector<RigidBodyId2D>& activeBodies)
+    void IslandManager::BuildIslands(std::span<const RigidBodyId2D> activeBodies)
     {
         U32 currentIsland = 0;
         U32 currentCount = 0;
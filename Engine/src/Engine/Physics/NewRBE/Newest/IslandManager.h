@@ -23,10 +23,10 @@ namespace Engine::WIP::Physics::Newest
 
         U32 GetIslandCount() const { return m_IslandCount; }
         void Clear();
-        void Finalize(const std::vector<RigidBodyId2D>& activeBodies);
+        void Finalize(std::span<const RigidBodyId2D> activeBodies);
     private:
         U32 GetLowestLinkIndex(U32 body);
-        void BuildIslands(const std::vector<RigidBodyId2D>& activeBodies);
+        void BuildIslands(std::span<const RigidBodyId2D> activeBodies);
     private:
         U32 m_MaxBodies{0};
         U32 m_IslandCount{0};
@@ -4,6 +4,9 @@
 #include "Collision/NarrowPhase/Contact.h"
 #include "Engine/Common/TwoFrameBuffer.h"
 #include "Engine/Core/Types.h"
+#include "Engine/Memory/MemoryManager.h"
+
+#include <memory_resource>
 
 namespace Engine::WIP::Physics::Newest
 {
@@ -13,9 +16,13 @@ namespace Engine::WIP::Physics::Newest
     
     struct PhysicsFrameContext
     {
+        explicit PhysicsFrameContext(std::pmr::memory_resource* resource = MemoryManager::GetMemoryResource())
+            : ContactsCache(resource)
+        {}
+
         F32 DeltaTime{0.0f};
 
-        TwoFrameBuffer<std::unordered_map<BodyPairHash, ContactInfo2D>> ContactsCache;
+        TwoFrameBuffer<std::pmr::unordered_map<BodyPairHash, ContactInfo2D>> ContactsCache;
 
         FrameContextContactAllocator ContactAllocator{2_MiB};
     };
@@ -34,8 +34,8 @@ namespace Engine::WIP::Physics::Newest
         //TODO: Resolve positions.
         
         //TODO: Move it away.
-        const std::vector<RigidBody2D*>& bodies = m_BodyManager.GetBodies();
-        const std::vector<RigidBodyId2D>& activeBodies = m_BodyManager.GetActiveBodies();
+        const std::pmr::vector<RigidBody2D*>& bodies = m_BodyManager.GetBodies();
+        const std::pmr::vector<RigidBodyId2D>& activeBodies = m_BodyManager.GetActiveBodies();
         for (RigidBodyId2D id : activeBodies)
         {
             RigidBody2D* body = bodies[id];
@@ -54,7 +54,7 @@ namespace Engine::WIP::Physics::Newest
 
     void PhysicsSystem::UpdateBodyCollider(RigidBodyId2D bodyId)
     {
-        const std::vector<RigidBody2D*>& bodies = m_BodyManager.GetBodies();
+        const std::pmr::vector<RigidBody2D*>& bodies = m_BodyManager.GetBodies();
         RigidBody2D* body = bodies[bodyId];
         ENGINE_CORE_CHECK_RETURN(body->IsInBroadPhase(), "Body is not in the broad phase.")
         if (!body->IsStatic()) body->RecalculateMass();
@@ -65,8 +65,8 @@ namespace Engine::WIP::Physics::Newest
     void PhysicsSystem::IntegrateVelocities()
     {
         F32 dt = m_FrameContext.DeltaTime;
-        const std::vector<RigidBody2D*>& bodies = m_BodyManager.GetBodies();
-        const std::vector<RigidBodyId2D>& activeBodies = m_BodyManager.GetActiveBodies();
+        const std::pmr::vector<RigidBody2D*>& bodies = m_BodyManager.GetBodies();
+        const std::pmr::vector<RigidBodyId2D>& activeBodies = m_BodyManager.GetActiveBodies();
         for (RigidBodyId2D id : activeBodies)
         {
             RigidBody2D* body = bodies[id];
@@ -113,7 +113,7 @@ namespace Engine::WIP::Physics::Newest
         m_IslandManager.Finalize(m_BodyManager.GetActiveBodies());
     }
 
-    void PhysicsSystem::ProcessPairs(const std::vector<BroadContactPair>& pairs)
+    void PhysicsSystem::ProcessPairs(const FrameVector<BroadContactPair>& pairs)
     {
         // First try to find this pair in cache.
         // If it is in cache, it means that there was a contact frame before,
@@ -161,8 +161,8 @@ namespace Engine::WIP::Physics::Newest
     void PhysicsSystem::IntegratePositions()
     {
         F32 dt = m_FrameContext.DeltaTime;
-        const std::vector<RigidBody2D*>& bodies = m_BodyManager.GetBodies();
-        const std::vector<RigidBodyId2D>& activeBodies = m_BodyManager.GetActiveBodies();
+        const std::pmr::vector<RigidBody2D*>& bodies = m_BodyManager.GetBodies();
+        const std::pmr::vector<RigidBodyId2D>& activeBodies = m_BodyManager.GetActiveBodies();
         for (RigidBodyId2D id : activeBodies)
         {
             RigidBody2D* body = bodies[id];
@@ -179,8 +179,8 @@ namespace Engine::WIP::Physics::Newest
     void PhysicsSystem::SynchronizeBroadPhase()
     {
         F32 dt = m_FrameContext.DeltaTime;
-        const std::vector<RigidBody2D*>& bodies = m_BodyManager.GetBodies();
-        const std::vector<RigidBodyId2D>& activeBodies = m_BodyManager.GetActiveBodies();
+        const std::pmr::vector<RigidBody2D*>& bodies = m_BodyManager.GetBodies();
+        const std::pmr::vector<RigidBodyId2D>& activeBodies = m_BodyManager.GetActiveBodies();
         for (RigidBodyId2D id : activeBodies)
         {
             RigidBody2D* body = bodies[id];
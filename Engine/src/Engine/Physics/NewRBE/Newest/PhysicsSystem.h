@@ -18,6 +18,10 @@ namespace Engine::WIP::Physics::Newest
         //TODO: temp.
         friend class ::Engine::RigidBodyWorldDrawer; 
     public:
+        // `resource` is used by containers of body manager, broad phase and frame context.
+        explicit PhysicsSystem(std::pmr::memory_resource* resource = MemoryManager::GetMemoryResource())
+            : m_BodyManager(resource), m_BroadPhase(resource), m_FrameContext(resource)
+        {}
         // TODO: provide max active bodies.
         void Init(U32 maxBodies, Ref<BroadPhaseLayers> bpLayers, Ref<BodyToBroadPhaseLayerFilter> bpFilter);
         void ShutDown();
@@ -33,13 +37,13 @@ namespace Engine::WIP::Physics::Newest
         void SynchronizeBroadPhase();
         void IntegrateVelocities();
         void ProcessCollisions();
-        void ProcessPairs(const std::vector<BroadContactPair>& pairs);
+        void ProcessPairs(const FrameVector<BroadContactPair>& pairs);
         void IntegratePositions();
     private:
         BodyManager m_BodyManager;
         BroadPhase2D m_BroadPhase;
         IslandManager m_IslandManager;
-        PhysicsFrameContext m_FrameContext{};
+        PhysicsFrameContext m_FrameContext;
         PhysicsSettings m_Settings{};
     };
 }
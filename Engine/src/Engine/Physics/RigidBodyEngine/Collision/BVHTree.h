@@ -13,13 +13,13 @@ namespace Engine
 
 namespace Engine::Physics
 {
-	template <typename Bounds>
+	template <typename BoundsType>
 	struct BVHNode
 	{
 		static constexpr auto NULL_NODE = -1;
 		static constexpr auto NULL_ITEM = -1;
 		// Stores enlarged bounds (box2d like).
-		Bounds Bounds;
+		BoundsType Bounds;
 		I32 LeftChild = NULL_NODE;
 		I32 RightChild = NULL_NODE;
 		// 0 for leaves, -1 if node is free.
@@ -154,8 +154,8 @@ namespace Engine::Physics
 		// This collider will be copied.
 		Collider2D* Collider{nullptr};
 		Component::LocalToWorldTransform2D* AttachedTransform{nullptr};
-		PhysicsMaterial PhysicsMaterial{};
-		Filter Filter{};
+		Physics::PhysicsMaterial PhysicsMaterial{};
+		Physics::Filter Filter{};
 		bool IsSensor{false};
 		void* UserData{nullptr};
 		Collider2D* Clone() const;
@@ -21,9 +21,6 @@ namespace Engine::Physics
 
     struct AABB2D;
     struct CircleBounds2D;
-    struct Component::LocalToWorldTransform2D;
-    struct Engine::LineSegment2D;
-    struct Engine::Line2D;
     class BoxCollider2D;
     class EdgeCollider2D;
 
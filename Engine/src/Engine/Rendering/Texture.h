@@ -56,7 +56,7 @@ namespace Engine
 			std::string Name = "Default";
 			U8* Data = nullptr;
 			U32 Width = 0, Height = 0;
-			PixelFormat PixelFormat = PixelFormat::RGBA;
+			Texture::PixelFormat PixelFormat = Texture::PixelFormat::RGBA;
 			Filter Minification = Filter::Nearest, Magnification = Filter::MipmapLinear;
 			WrapMode WrapS = WrapMode::Repeat; WrapMode WrapT = WrapMode::Repeat;
 			bool GenerateMipmaps = true;
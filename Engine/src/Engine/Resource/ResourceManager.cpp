@@ -5,10 +5,14 @@
 
 #include "Engine/Core/Log.h"
 
+#ifdef _MSC_VER
 #pragma warning (push, 0)
+#endif
 #include <stb_image/stb_image.h>
 #include <msdf-atlas-gen/msdf-atlas-gen.h>
+#ifdef _MSC_VER
 #pragma warning (pop)
+#endif
 
 namespace Engine
 {
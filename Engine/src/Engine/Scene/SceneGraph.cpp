@@ -8,24 +8,37 @@
 
 namespace Engine
 {
-    SceneGraph::SceneGraph(Registry& m_Registry)
-        : m_Registry(m_Registry)
+    SceneGraph::SceneGraph(Registry& m_Registry, std::pmr::memory_resource* resource)
+        : m_TransformHierarchy(resource), m_FlattenedWorldTransforms(resource), m_Registry(m_Registry)
     {
         m_TransformHierarchy.resize(128);
     }
 
     void SceneGraph::OnUpdate()
     {
-        const std::vector<Entity>& topLevelEntities = FindTopLevelEntities();
+        if (m_IsHierarchyFlattened)
+        {
+            if (GetParentRelCount() != m_FlattenedCount) RebuildHierarchyOrder();
+            UpdateTransformsFlattened(0, m_FlattenedCount);
+            return;
+        }
+        const FrameVector<Entity> topLevelEntities = FindTopLevelEntities();
         UpdateTransforms(topLevelEntities);
     }
 
     void SceneGraph::UpdateGraphOfEntity(Entity entity)
     {
-        UpdateTransforms({entity});
+        if (m_IsHierarchyFlattened)
+        {
+            if (GetParentRelCount() != m_FlattenedCount) RebuildHierarchyOrder();
+            auto [begin, end] = GetDescendantsRange(entity);
+            UpdateTransformsFlattened(begin, end);
+            return;
+        }
+        UpdateTransforms(std::span<const Entity>(&entity, 1));
     }
 
-    void SceneGraph::UpdateTransforms(const std::vector<Entity>& topLevelEntities)
+    void SceneGraph::UpdateTransforms(std::span<const Entity> topLevelEntities)
     {
         for (auto& tlayer : m_TransformHierarchy) tlayer.clear();
 
@@ -74,30 +87,31 @@ namespace Engine
         }
     }
 
-    std::vector<Entity> SceneGraph::FindTopLevelEntities()
+    FrameVector<Entity> SceneGraph::FindTopLevelEntities()
     {
-        std::vector<Entity> result;
-        std::unordered_map<Entity, bool> traversal;
-        for (auto e : View<Component::ChildRel>(m_Registry))
-        {
-            if (traversal[e]) continue;
-            // Mark all of it's children.
-            MarkHierarchyOf(e, traversal);
-
-            if (!m_Registry.Has<Component::ParentRel>(e))
+        FrameVector<Entity> result;
+        FrameUnorderedMap<Entity, bool> traversal;
+        View<Component::ChildRel, Optional<Component::ParentRel>>(m_Registry).Each(
+            [&](Entity e, auto&, auto* parentRel)
             {
-                result.push_back(e);
-                continue;
-            }
+                if (traversal[e]) return;
+                // Mark all of it's children.
+                MarkHierarchyOf(e, traversal);
 
-            Entity topOfTree = SceneUtils::FindTopOfTree(e, m_Registry);
-            MarkHierarchyOf(topOfTree, traversal);
-            result.push_back(topOfTree);
-        }
+                if (parentRel == nullptr)
+                {
+                    result.push_back(e);
+                    return;
+                }
+
+                Entity topOfTree = SceneUtils::FindTopOfTree(e, m_Registry);
+                MarkHierarchyOf(topOfTree, traversal);
+                result.push_back(topOfTree);
+            });
         return result;
     }
 
-    void SceneGraph::MarkHierarchyOf(Entity entity, std::unordered_map<Entity, bool>& traversalMap)
+    void SceneGraph::MarkHierarchyOf(Entity entity, FrameUnorderedMap<Entity, bool>& traversalMap)
     {
         if (traversalMap[entity]) return;
         traversalMap[entity] = true;
@@ -129,4 +143,238 @@ namespace Engine
             eTfLocal.Position = glm::vec2{0.0f, 0.0f};
         }
     }
+
+    void SceneGraph::SetFlattenedHierarchy(bool isFlattened)
+    {
+        m_IsHierarchyFlattened = isFlattened;
+        if (m_IsHierarchyFlattened) RebuildHierarchyOrder();
+        else
+        {
+            m_FlattenedWorldTransforms.clear();
+            m_FlattenedWorldTransforms.shrink_to_fit();
+        }
+    }
+
+    void SceneGraph::RebuildHierarchyOrder()
+    {
+        m_FlattenedCount = GetParentRelCount();
+        if (m_FlattenedCount == 0) return;
+        // Depth-first traversal from every top-level entity, children of the popped entity are visited before its siblings.
+        std::vector<Entity> order;
+        order.reserve(m_FlattenedCount);
+        std::vector<Entity> stack;
+        View<Component::ChildRel, Optional<Component::ParentRel>>(m_Registry).Each(
+            [&](Entity e, auto&, auto* parentRel)
+            {
+                if (parentRel != nullptr) return;
+                SceneUtils::TraverseChildren(e, m_Registry, [&](Entity child) { stack.push_back(child); });
+                while (!stack.empty())
+                {
+                    Entity curr = stack.back(); stack.pop_back();
+                    order.push_back(curr);
+                    if (m_Registry.Has<Component::ChildRel>(curr))
+                    {
+                        SceneUtils::TraverseChildren(curr, m_Registry, [&](Entity child) { stack.push_back(child); });
+                    }
+                }
+            });
+        // Entities, that are not reachable from top-level ones (broken hierarchy), stay at the back.
+        m_Registry.Arrange<Component::ParentRel>(order);
+        UpdateParentIndices(0, m_FlattenedCount);
+
+        // Children go after parents, so subtree sizes are accumulated in reverse order.
+        const auto& entities = m_Registry.GetComponentPool<Component::ParentRel>().GetDenseEntities();
+        for (U32 i = 0; i < m_FlattenedCount; i++) m_Registry.Get<Component::ParentRel>(entities[i]).DescendantCount = 0;
+        for (I32 i = static_cast<I32>(m_FlattenedCount) - 1; i >= 0; i--)
+        {
+            auto& parentRel = m_Registry.Get<Component::ParentRel>(entities[i]);
+            if (parentRel.ParentIndex < 0) continue;
+            m_Registry.Get<Component::ParentRel>(entities[parentRel.ParentIndex]).DescendantCount += parentRel.DescendantCount + 1;
+        }
+    }
+
+    void SceneGraph::OnChildAdded(Entity child)
+    {
+        const auto& pool = m_Registry.GetComponentPool<Component::ParentRel>();
+        U32 count = pool.GetComponentCount();
+        // `ParentRel` was added or removed elsewhere (deserialization, etc.), the order is not maintained.
+        if (count != m_FlattenedCount + 1)
+        {
+            RebuildHierarchyOrder();
+            return;
+        }
+        // New `ParentRel` may not be the last one (if pool was reordered elsewhere), move it to the back.
+        U32 childIndex = pool.TryGetComponentIndex(child);
+        RotateHierarchy(childIndex, childIndex + 1, count);
+        // Child was top-level, so its descendants are children ranges of their own, move them right after it.
+        auto [descendantsBegin, descendantsEnd] = GetChildrenRange(child, NULL_ENTITY);
+        U32 descendantCount = descendantsEnd - descendantsBegin;
+        RotateHierarchy(descendantsBegin, descendantsEnd, count);
+        U32 subtreeBegin = count - descendantCount - 1;
+
+        // Subtree goes to the end of parent's subtree, or to the end of the range of parent's children (if top-level).
+        Entity parent = m_Registry.Get<Component::ParentRel>(child).Parent;
+        U32 target = subtreeBegin;
+        const U32 parentIndex = pool.TryGetComponentIndex(parent);
+        if (parentIndex != pool.GetNullIndex())
+        {
+            target = parentIndex + 1 + m_Registry.Get<Component::ParentRel>(parent).DescendantCount;
+        }
+        else if (auto [siblingsBegin, siblingsEnd] = GetChildrenRange(parent, child); siblingsBegin != siblingsEnd)
+        {
+            target = siblingsEnd;
+        }
+        RotateHierarchy(target, subtreeBegin, count);
+
+        auto& parentRel = m_Registry.Get<Component::ParentRel>(child);
+        parentRel.DescendantCount = descendantCount;
+        parentRel.ParentIndex = parentIndex == pool.GetNullIndex() ? -1 : static_cast<I32>(parentIndex);
+        SetChildrenParentIndex(child, static_cast<I32>(target));
+        AddDescendantCount(parent, static_cast<I32>(descendantCount + 1));
+        m_FlattenedCount = count;
+    }
+
+    void SceneGraph::OnChildRemoving(Entity child)
+    {
+        if (GetParentRelCount() != m_FlattenedCount) RebuildHierarchyOrder();
+        const auto& pool = m_Registry.GetComponentPool<Component::ParentRel>();
+        U32 count = pool.GetComponentCount();
+        auto& parentRel = m_Registry.Get<Component::ParentRel>(child);
+        U32 descendantCount = parentRel.DescendantCount;
+        AddDescendantCount(parentRel.Parent, -static_cast<I32>(descendantCount + 1));
+        // Subtree leaves the ranges of former ancestors for the back of the pool, where descendants become
+        // the children range of (now top-level) `child`, that goes last, so that it is popped without breaking the order.
+        U32 childIndex = pool.TryGetComponentIndex(child);
+        RotateHierarchy(childIndex, childIndex + descendantCount + 1, count);
+        RotateHierarchy(count - descendantCount - 1, count - descendantCount, count);
+        SetChildrenParentIndex(child, -1);
+        m_FlattenedCount = count - 1;
+    }
+
+    void SceneGraph::DeleteDescendants(Entity entity)
+    {
+        ENGINE_CORE_ASSERT(!m_Registry.Has<Component::ParentRel>(entity), "Entity shall be top-level")
+        if (GetParentRelCount() != m_FlattenedCount) RebuildHierarchyOrder();
+        auto [begin, end] = GetChildrenRange(entity, NULL_ENTITY);
+        if (begin == end) return;
+        const auto& pool = m_Registry.GetComponentPool<Component::ParentRel>();
+        U32 count = pool.GetComponentCount();
+        // Parents of the rest of the pool are outside of the deleted range.
+        RotateHierarchy(begin, end, count);
+        U32 remainingCount = count - (end - begin);
+        while (pool.GetComponentCount() > remainingCount) m_Registry.DeleteEntity(pool.GetDenseEntities().back());
+        m_FlattenedCount = remainingCount;
+    }
+
+    std::pair<U32, U32> SceneGraph::GetDescendantsRange(Entity entity) const
+    {
+        if (GetParentRelCount() == 0) return {0, 0};
+        const Registry& registry = m_Registry;
+        const auto& pool = registry.GetComponentPool<Component::ParentRel>();
+        if (U32 index = pool.TryGetComponentIndex(entity); index != pool.GetNullIndex())
+        {
+            return {index + 1, index + 1 + registry.Get<Component::ParentRel>(entity).DescendantCount};
+        }
+        return GetChildrenRange(entity, NULL_ENTITY);
+    }
+
+    void SceneGraph::UpdateTransformsFlattened(U32 begin, U32 end)
+    {
+        if (begin == end) return;
+        const Registry& registry = m_Registry;
+        const auto& entities = registry.GetComponentPool<Component::ParentRel>().GetDenseEntities();
+        if (m_FlattenedWorldTransforms.size() < end) m_FlattenedWorldTransforms.resize(end);
+        for (U32 i = begin; i < end; i++)
+        {
+            Entity e = entities[i];
+            const auto& parentRel = registry.Get<Component::ParentRel>(e);
+            const auto& parentTf = parentRel.ParentIndex >= static_cast<I32>(begin) ?
+                m_FlattenedWorldTransforms[parentRel.ParentIndex] :
+                registry.Get<Component::LocalToWorldTransform2D>(parentRel.Parent);
+            Component::LocalToWorldTransform2D worldTf = registry.Get<Component::LocalToParentTransform2D>(e);
+            m_FlattenedWorldTransforms[i] = worldTf.Concatenate(parentTf);
+            m_Registry.Get<Component::LocalToWorldTransform2D>(e) = m_FlattenedWorldTransforms[i];
+        }
+    }
+
+    void SceneGraph::UpdateParentIndices(U32 begin, U32 end)
+    {
+        const auto& pool = m_Registry.GetComponentPool<Component::ParentRel>();
+        const auto& entities = pool.GetDenseEntities();
+        for (U32 i = begin; i < end; i++)
+        {
+            auto& parentRel = m_Registry.Get<Component::ParentRel>(entities[i]);
+            U32 parentIndex = pool.TryGetComponentIndex(parentRel.Parent);
+            parentRel.ParentIndex = parentIndex == pool.GetNullIndex() || parentIndex >= end ?
+                -1 : static_cast<I32>(parentIndex);
+        }
+    }
+
+    void SceneGraph::RotateHierarchy(U32 first, U32 middle, U32 last)
+    {
+        if (first == middle || middle == last) return;
+        m_Registry.Rotate<Component::ParentRel>(first, middle, last);
+        // Children go after parents, so only components from `first` may point into rotated range.
+        const auto& entities = m_Registry.GetComponentPool<Component::ParentRel>().GetDenseEntities();
+        const I32 count = static_cast<I32>(GetParentRelCount());
+        const I32 rightShift = static_cast<I32>(last - middle);
+        const I32 leftShift = static_cast<I32>(middle - first);
+        for (I32 i = static_cast<I32>(first); i < count; i++)
+        {
+            I32& parentIndex = m_Registry.Get<Component::ParentRel>(entities[i]).ParentIndex;
+            if (parentIndex < static_cast<I32>(first) || parentIndex >= static_cast<I32>(last)) continue;
+            parentIndex += parentIndex < static_cast<I32>(middle) ? rightShift : -leftShift;
+        }
+    }
+
+    void SceneGraph::SetChildrenParentIndex(Entity parent, I32 parentIndex)
+    {
+        if (!m_Registry.Has<Component::ChildRel>(parent)) return;
+        Entity child = m_Registry.Get<Component::ChildRel>(parent).First;
+        while (child != NULL_ENTITY)
+        {
+            auto& parentRel = m_Registry.Get<Component::ParentRel>(child);
+            parentRel.ParentIndex = parentIndex;
+            child = parentRel.Next;
+        }
+    }
+
+    std::pair<U32, U32> SceneGraph::GetChildrenRange(Entity parent, Entity exceptChild) const
+    {
+        const Registry& registry = m_Registry;
+        if (!registry.Has<Component::ChildRel>(parent)) return {0, 0};
+        const auto& pool = registry.GetComponentPool<Component::ParentRel>();
+        U32 begin = pool.GetNullIndex();
+        U32 end = 0;
+        Entity child = registry.Get<Component::ChildRel>(parent).First;
+        while (child != NULL_ENTITY)
+        {
+            const auto& parentRel = registry.Get<Component::ParentRel>(child);
+            if (child != exceptChild)
+            {
+                U32 index = pool.TryGetComponentIndex(child);
+                begin = std::min(begin, index);
+                end = std::max(end, index + 1 + parentRel.DescendantCount);
+            }
+            child = parentRel.Next;
+        }
+        if (begin > end) return {0, 0};
+        return {begin, end};
+    }
+
+    void SceneGraph::AddDescendantCount(Entity entity, I32 count)
+    {
+        while (m_Registry.Has<Component::ParentRel>(entity))
+        {
+            auto& parentRel = m_Registry.Get<Component::ParentRel>(entity);
+            parentRel.DescendantCount += count;
+            entity = parentRel.Parent;
+        }
+    }
+
+    U32 SceneGraph::GetParentRelCount() const
+    {
+        if (!m_Registry.IsComponentExists(ComponentFamily::TYPE<Component::ParentRel>)) return 0;
+        return m_Registry.GetComponentPool<Component::ParentRel>().GetComponentCount();
+    }
 }
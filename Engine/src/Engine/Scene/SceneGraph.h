@@ -1,6 +1,11 @@
 ﻿#pragma once
 #include "Engine/ECS/Components.h"
 #include "Engine/ECS/EntityId.h"
+#include "Engine/Memory/FrameAllocator.h"
+#include "Engine/Memory/MemoryManager.h"
+
+#include <memory_resource>
+#include <span>
 
 namespace Engine
 {
@@ -14,18 +19,54 @@ namespace Engine
             Component::LocalToWorldTransform2D WorldTransform;
         };
     public:
-        SceneGraph(Registry& registry);
+        // `resource` is used by transform hierarchy containers.
+        SceneGraph(Registry& registry, std::pmr::memory_resource* resource = MemoryManager::GetMemoryResource());
         void OnUpdate();
         void UpdateGraphOfEntity(Entity entity);
         void ReflectEntityTransformToPrefabTransform();
+
+        // Optional flattened hierarchy: `ParentRel` pool is kept in depth-first order (parent goes before its subtree,
+        // which is contiguous, subtrees of children of the same top-level entity are contiguous as well),
+        // and `ParentRel::ParentIndex` points to parent's `ParentRel`, so that transforms are propagated,
+        // and subtrees are deleted with linear walks over the pool.
+        // The order is updated incrementally by `SceneUtils::AddChild / RemoveChild / DeleteEntity`, if `ParentRel`
+        // is added or removed by anything else (deserialization, etc.), `OnUpdate` and incremental updates rebuild it
+        // (when the count differs), otherwise `RebuildHierarchyOrder` shall be called.
+        void SetFlattenedHierarchy(bool isFlattened);
+        bool IsHierarchyFlattened() const { return m_IsHierarchyFlattened; }
+        void RebuildHierarchyOrder();
+        // Called by `SceneUtils::AddChild` once `child` is attached, places it with its subtree after parent's subtree.
+        void OnChildAdded(Entity child);
+        // Called by `SceneUtils::RemoveChild` before `ParentRel` of `child` is removed, moves it to the back of the pool.
+        void OnChildRemoving(Entity child);
+        // Deletes every descendant of top-level `entity` (from the back of the pool, so that the order stays intact).
+        void DeleteDescendants(Entity entity);
+        // Range of `ParentRel` pool, that holds descendants of `entity`.
+        std::pair<U32, U32> GetDescendantsRange(Entity entity) const;
     private:
-        void UpdateTransforms(const std::vector<Entity>& topLevelEntities);
-        std::vector<Entity> FindTopLevelEntities();
-        void MarkHierarchyOf(Entity entity, std::unordered_map<Entity, bool>& traversalMap);
+        void UpdateTransforms(std::span<const Entity> topLevelEntities);
+        FrameVector<Entity> FindTopLevelEntities();
+        void MarkHierarchyOf(Entity entity, FrameUnorderedMap<Entity, bool>& traversalMap);
 
-        
+        // Propagates transforms to `ParentRel` pool range, parents outside of it shall be up to date.
+        void UpdateTransformsFlattened(U32 begin, U32 end);
+        // Components past `end` are treated as not being in the pool.
+        void UpdateParentIndices(U32 begin, U32 end);
+        // Rotates `ParentRel` pool range (as `std::rotate`) and fixes up parent indices that pointed into it.
+        void RotateHierarchy(U32 first, U32 middle, U32 last);
+        void SetChildrenParentIndex(Entity parent, I32 parentIndex);
+        // Range of subtrees of `parent`'s children (except `exceptChild`), for entities without `ParentRel`.
+        std::pair<U32, U32> GetChildrenRange(Entity parent, Entity exceptChild) const;
+        void AddDescendantCount(Entity entity, I32 count);
+        U32 GetParentRelCount() const;
     private:
-        std::vector<std::vector<EntityWorldTransformInfo>> m_TransformHierarchy{};
+        std::pmr::vector<std::pmr::vector<EntityWorldTransformInfo>> m_TransformHierarchy;
+
+        // Parallel to `ParentRel` pool.
+        std::pmr::vector<Component::LocalToWorldTransform2D> m_FlattenedWorldTransforms;
+        // `ParentRel` count, the order was last maintained for.
+        U32 m_FlattenedCount{0};
+        bool m_IsHierarchyFlattened{false};
 
         std::unordered_map<Entity, bool> m_DrawTraversalMap;
         
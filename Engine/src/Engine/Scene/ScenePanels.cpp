@@ -215,13 +215,13 @@ namespace Engine
         std::unordered_map<Entity, bool> traversal;
         auto& registry = m_Scene.GetRegistry();
 
-        for (auto e : View<>(registry))
+        View<Optional<Component::ParentRel>>(registry).Each([&](Entity e, auto* parentRel)
         {
-            if (traversal[e]) continue;
+            if (traversal[e]) return;
             MarkHierarchyOf(e, traversal);
-            if (registry.Has<Component::ParentRel>(e)) continue;
+            if (parentRel != nullptr) return;
             result.push_back(e);
-        }
+        });
 
         return result;
     }
@@ -110,7 +110,7 @@ namespace Engine
         auto newUIDesc = CreateRef<T>(m_Scene);
         auto it = std::ranges::find_if(m_ComponentUIDescriptions, [&](auto& el)
         {
-            return el->GetSignature() == newUIDesc->GetSignature();
+            return el->GetComponentID() == newUIDesc->GetComponentID();
         });
         if (it != m_ComponentUIDescriptions.end()) return;
         m_ComponentUIDescriptions.push_back(newUIDesc);
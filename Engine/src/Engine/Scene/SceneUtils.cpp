@@ -60,6 +60,16 @@ namespace Engine
             return;
         }
         
+        auto& sceneGraph = scene.GetSceneGraph();
+        if (sceneGraph.IsHierarchyFlattened())
+        {
+            // Once detached, entity is top-level, and its descendants are deleted with a linear walk.
+            if (registry.Has<Component::ParentRel>(entity)) RemoveChild(scene, entity, false);
+            sceneGraph.DeleteDescendants(entity);
+            registry.DeleteEntity(entity);
+            return;
+        }
+        
         // Before deleting entity, detach it from parent (if any) and delete it's children (if any).
         if (registry.Has<Component::ChildRel>(entity))
         {
@@ -157,6 +167,8 @@ namespace Engine
             col.PhysicsCollider->SetAttachedTransform(&tf);
             SceneUtils::SynchronizePhysics(scene, e, SceneUtils::PhysicsSynchroSetting::ColliderOnly);
         }
+        // World transforms do not move on removal, so attached pointers only change
+        // if transform pool was compacted or restored from snapshot.
         for (auto e : View<Component::RigidBody2D>(registry))
         {
             auto& tf = registry.Get<Component::LocalToWorldTransform2D>(e);
@@ -219,27 +231,6 @@ namespace Engine
         }
     }
 
-    void SceneUtils::SynchronizeWithPhysics(Scene& scene, Entity entity)
-    {
-        auto& registry = scene.GetRegistry();
-        ENGINE_CORE_ASSERT(registry.Has<Component::LocalToWorldTransform2D>(entity), "Transform is unset")
-        if (registry.Has<Component::RigidBody2D>(entity) == false)
-        {
-            ENGINE_CORE_WARN("Rigid body component is unset, while explicitly requesting to sync with physics.");
-            return;
-        }
-        auto& tf = registry.Get<Component::LocalToWorldTransform2D>(entity);
-        auto& localToWorld = registry.Get<Component::LocalToWorldTransform2D>(entity);
-        auto& rb = registry.Get<Component::RigidBody2D>(entity);
-        if (rb.PhysicsBody == nullptr)
-        {
-            ENGINE_CORE_WARN("Entity {} has no physical rigid body attached.", entity.GetIndex());
-        }
-        tf.Position = rb.PhysicsBody->GetPosition();
-        tf.Rotation = rb.PhysicsBody->GetRotation();
-        localToWorld = {tf.Position, tf.Scale, tf.Rotation};
-    }
-
     void SceneUtils::SynchronizeWithPhysicsLocal(Scene& scene, Entity entity)
     {
         auto& registry = scene.GetRegistry();
@@ -298,6 +289,7 @@ namespace Engine
             childParentRel.Next = childRel.First;
         }
         childRel.First = child;
+        U32 childDepth = childParentRel.Depth;
         // Change transform, so that child stays in place when attached.
         switch (localTransformPolicy)
         {
@@ -314,11 +306,20 @@ namespace Engine
                 break;
             }
         }
-        // Update all `child` children depth.
+        // Update all `child` children depth (they were relative to `child` as top-level entity).
+        auto& sceneGraph = scene.GetSceneGraph();
+        if (sceneGraph.IsHierarchyFlattened())
+        {
+            sceneGraph.OnChildAdded(child);
+            auto [begin, end] = sceneGraph.GetDescendantsRange(child);
+            const auto& entities = registry.GetComponentPool<Component::ParentRel>().GetDenseEntities();
+            for (U32 i = begin; i < end; i++) registry.Get<Component::ParentRel>(entities[i]).Depth += childDepth;
+            return;
+        }
         TraverseExceptRoot(child, registry, [&](Entity e)
         {
             auto& parentRel = registry.Get<Component::ParentRel>(e);
-            parentRel.Depth += 1;
+            parentRel.Depth += childDepth;
         });
     }
 
@@ -345,11 +346,23 @@ namespace Engine
         parentChildRef.ChildrenCount--;
 
         // Update all `child` children depth.
-        TraverseExceptRoot(child, registry, [&](Entity e)
+        U32 childDepth = parentRel.Depth;
+        auto& sceneGraph = scene.GetSceneGraph();
+        if (sceneGraph.IsHierarchyFlattened())
         {
-            auto& parentRelE = registry.Get<Component::ParentRel>(e);
-            parentRelE.Depth -= 1;
-        });
+            auto [begin, end] = sceneGraph.GetDescendantsRange(child);
+            const auto& entities = registry.GetComponentPool<Component::ParentRel>().GetDenseEntities();
+            for (U32 i = begin; i < end; i++) registry.Get<Component::ParentRel>(entities[i]).Depth -= childDepth;
+            sceneGraph.OnChildRemoving(child);
+        }
+        else
+        {
+            TraverseExceptRoot(child, registry, [&](Entity e)
+            {
+                auto& parentRelE = registry.Get<Component::ParentRel>(e);
+                parentRelE.Depth -= childDepth;
+            });
+        }
 
         registry.Remove<Component::ParentRel>(child);
         registry.Remove<Component::LocalToParentTransform2D>(child);
@@ -375,13 +388,6 @@ namespace Engine
         return BFS(parent, child, registry);
     }
 
-    Entity SceneUtils::FindTopOfTree(Entity treeEntity, Registry& registry)
-    {
-        Entity curr = treeEntity;
-        while (registry.Has<Component::ParentRel>(curr)) curr = registry.Get<Component::ParentRel>(curr).Parent;
-        return curr;
-    }
-
     Entity SceneUtils::FindParentingPrefab(Entity entity, Registry& registry)
     {
         auto& belToPrefab = registry.Get<Component::BelongsToPrefab>(entity);
@@ -14,7 +14,7 @@ namespace  Engine
     {
         struct EntityTransformPair
         {
-            Entity Entity;
+            Engine::Entity Entity;
             Component::LocalToWorldTransform2D& Transform2D;
         };
     
@@ -46,8 +46,7 @@ namespace  Engine
         // Reflects component state to physics state.
         static void SynchronizePhysics(Scene& scene, Entity entity, PhysicsSynchroSetting synchroSetting = PhysicsSynchroSetting::Full);
         static void SynchronizePhysics(Scene& scene);
-        // Reflects physics state to component state.
-        static void SynchronizeWithPhysics(Scene& scene, Entity entity);
+        // Reflects physics state to component state (world transforms are written by physics directly).
         static void SynchronizeWithPhysicsLocal(Scene& scene, Entity entity);
 
         // To be called once OnInit(), so that initial cameras position corresponds to the deserialized transforms.
@@ -142,6 +141,14 @@ namespace  Engine
             curr = next;
         }
     }
+
+    // Defined here, so that scene graph does not depend on the rest of scene utils.
+    inline Entity SceneUtils::FindTopOfTree(Entity treeEntity, Registry& registry)
+    {
+        Entity curr = treeEntity;
+        while (registry.Has<Component::ParentRel>(curr)) curr = registry.Get<Component::ParentRel>(curr).Parent;
+        return curr;
+    }
 }
 
 
@@ -22,6 +22,8 @@ namespace Engine
         virtual void DeserializeComponentOf(Entity e, YAML::Node& node) = 0;
         virtual void AddEmptyComponentTo(Entity e) = 0;
         virtual bool SupportsCreationInEditor() = 0;
+        // Stable id of serialized component.
+        virtual U64 GetComponentID() const = 0;
         
         virtual void FillEntityRelationsMap(Entity e, std::unordered_map<Entity, std::vector<Entity*>>& map) {}
 
@@ -44,6 +46,7 @@ namespace Engine
         void DeserializeComponentOf(Entity e, YAML::Node& node) override;
         void AddEmptyComponentTo(Entity e) override {}
         bool SupportsCreationInEditor() override { return false; }
+        U64 GetComponentID() const override { return ComponentFamily::STABLE_ID<T>; }
 
     protected:
         virtual void SerializeComponent(const T& component, YAML::Emitter& emitter) = 0;
@@ -35,19 +35,17 @@ namespace Engine
 
         // Prefabs.
         emitter << YAML::Key << "Prefabs" << YAML::Value << YAML::BeginSeq;
-        for (auto e : View<Component::Prefab>(registry))
+        for (auto e : View<Component::Prefab>::Exclude<Component::BelongsToPrefab>(registry))
         {
-            if (!registry.Has<Component::BelongsToPrefab>(e)) SerializePrefab(e, emitter);
+            SerializePrefab(e, emitter);
         }
         emitter << YAML::EndSeq;
 
         // Entities.
         emitter << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
-        for (auto e : View<>(registry))
+        for (auto e : View<>::Exclude<Component::Prefab, Component::BelongsToPrefab>(registry))
         {
-            if (!registry.Has<Component::Prefab>(e) && !registry.Has<Component::BelongsToPrefab>(e))
-                SerializeEntity(
-                    e, emitter);
+            SerializeEntity(e, emitter);
         }
         emitter << YAML::EndSeq;
 
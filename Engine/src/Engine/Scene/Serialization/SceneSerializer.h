@@ -83,7 +83,7 @@ namespace Engine
         auto newSerializer = CreateRef<T>(m_Scene);
         auto it = std::ranges::find_if(m_ComponentSerializers, [&](auto& el)
         {
-            return el->GetSignature() == newSerializer->GetSignature();
+            return el->GetComponentID() == newSerializer->GetComponentID();
         });
         if (it != m_ComponentSerializers.end()) return;
         m_ComponentSerializers.push_back(newSerializer);
@@ -6,6 +6,7 @@
 #include <functional>
 #include <variant>
 #include <future>
+#include <atomic>
 #include <chrono>
 #include <compare>
 #include <concepts>
@@ -17,6 +18,7 @@
 #include <fstream>
 #include <vector>
 #include <array>
+#include <span>
 #include <map>
 #include <stack>
 #include <queue>
@@ -0,0 +1,52 @@
+project "EngineBench"
+	kind "ConsoleApp"	
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "off"
+
+	targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+	files
+	{
+		"src/**.cpp",
+		"src/**.h",
+		-- Headless subset of the engine (no window, renderer or editor dependencies),
+		-- so that benchmarks build without GLFW, glad, imgui, msdf and yaml-cpp.
+		"%{wks.location}/Engine/src/Engine/Core/Log.cpp",
+		"%{wks.location}/Engine/src/Engine/Core/JobSystem.cpp",
+		"%{wks.location}/Engine/src/Engine/Core/Time.cpp",
+		"%{wks.location}/Engine/src/Engine/Memory/**.cpp",
+		"%{wks.location}/Engine/src/Engine/ECS/EntityCommandBuffer.cpp",
+		"%{wks.location}/Engine/src/Engine/ECS/EntityManager.cpp",
+		"%{wks.location}/Engine/src/Engine/ECS/Registry.cpp",
+		"%{wks.location}/Engine/src/Engine/ECS/SystemGraph.cpp",
+		"%{wks.location}/Engine/src/Engine/Rendering/SortingLayer.cpp",
+	}
+
+	includedirs 
+	{
+		"%{wks.location}/Engine/src",
+		"%{IncludeDir.spdlog}",
+		"%{IncludeDir.glm}",
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+	filter "system:linux"
+		links { "pthread" }
+
+	filter { "configurations:Debug" }
+		defines "ENGINE_DEBUG"
+		runtime "Debug"
+		symbols "on"
+
+	filter { "configurations:Release" }
+		defines "ENGINE_RELEASE"
+		runtime "Release"
+		optimize "on"
+
+	filter { "configurations:Dist" }
+		defines "ENGINE_DIST"
+		runtime "Release"
+		optimize "speed"
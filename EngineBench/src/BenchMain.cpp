@@ -0,0 +1,79 @@
+#include "Benchmark.h"
+
+#include <Engine/Core/Log.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+// Counts heap allocations done by std containers and engine code, that bypasses `MemoryManager`.
+namespace
+{
+	std::atomic<U64> s_HeapAllocatedBytes{0};
+}
+
+void* operator new(std::size_t sizeBytes)
+{
+	s_HeapAllocatedBytes.fetch_add(sizeBytes, std::memory_order_relaxed);
+	if (void* memory = std::malloc(sizeBytes != 0 ? sizeBytes : 1)) return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t sizeBytes)
+{
+	return operator new(sizeBytes);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+U64 Bench::GetHeapAllocatedBytes()
+{
+	return s_HeapAllocatedBytes.load(std::memory_order_relaxed);
+}
+
+// Usage: EngineBench [--filter <substring>] [--sizes 1000,100000,1000000] [--out <file.json>]
+// Engine log goes to stdout as well, so use `--out` when the output is parsed.
+int main(int argc, char** argv)
+{
+	std::string filter;
+	std::vector<U32> sizes = { 1'000, 100'000, 1'000'000 };
+	std::string outPath;
+	for (I32 i = 1; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+		if (option == "--filter") filter = argv[i + 1];
+		else if (option == "--out") outPath = argv[i + 1];
+		else if (option == "--sizes")
+		{
+			sizes.clear();
+			std::stringstream sizesList(argv[i + 1]);
+			for (std::string size; std::getline(sizesList, size, ',');) sizes.push_back(static_cast<U32>(std::stoul(size)));
+		}
+		else
+		{
+			std::cerr << "Unknown option: " << option << "\n";
+			return 1;
+		}
+	}
+
+	Engine::Log::Init();
+	Engine::MemoryManager::Init();
+
+	auto results = Bench::RunBenchmarks(Bench::GetEcsBenchmarks(), sizes, filter);
+	if (outPath.empty())
+	{
+		Bench::WriteJson(std::cout, results);
+	}
+	else
+	{
+		std::ofstream out(outPath);
+		Bench::WriteJson(out, results);
+	}
+	return 0;
+}
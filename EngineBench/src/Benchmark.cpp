@@ -0,0 +1,48 @@
+#include "Benchmark.h"
+
+#include <iomanip>
+
+namespace Bench
+{
+	BenchmarkContext::BenchmarkContext(const std::string& name, U32 entityCount)
+	{
+		m_Result.Name = name;
+		m_Result.EntityCount = entityCount;
+	}
+
+	std::vector<BenchmarkResult> RunBenchmarks(const std::vector<BenchmarkCase>& cases, std::span<const U32> sizes, const std::string& filter)
+	{
+		std::vector<BenchmarkResult> results;
+		for (auto& benchmark : cases)
+		{
+			if (benchmark.Name.find(filter) == std::string::npos) continue;
+			for (U32 size : sizes)
+			{
+				BenchmarkContext context(benchmark.Name, size);
+				benchmark.Fn(context, size);
+				results.push_back(context.GetResult());
+			}
+		}
+		return results;
+	}
+
+	void WriteJson(std::ostream& out, const std::vector<BenchmarkResult>& results)
+	{
+		out << "{\n\t\"benchmarks\": [\n";
+		for (U32 i = 0; i < results.size(); i++)
+		{
+			auto& result = results[i];
+			out << "\t\t{"
+				<< "\"name\": \"" << result.Name << "\", "
+				<< "\"entities\": " << result.EntityCount << ", "
+				<< "\"repetitions\": " << result.Repetitions << ", "
+				<< "\"operations\": " << result.Operations << ", "
+				<< "\"ns_per_op\": " << std::fixed << std::setprecision(3) << result.NsPerOp << ", "
+				<< "\"bytes_allocated\": " << result.BytesAllocated << ", "
+				<< "\"heap_bytes_allocated\": " << result.HeapBytesAllocated << ", "
+				<< "\"steady_bytes_allocated\": " << result.SteadyBytesAllocated
+				<< "}" << (i + 1 < results.size() ? "," : "") << "\n";
+		}
+		out << "\t]\n}\n";
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Engine/Core/Types.h>
+#include <Engine/Memory/MemoryManager.h>
+
+#include <chrono>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace Engine::Types;
+
+namespace Bench
+{
+	// Total bytes requested from global operator new (see `BenchMain.cpp`).
+	U64 GetHeapAllocatedBytes();
+
+	struct BenchmarkResult
+	{
+		std::string Name;
+		U32 EntityCount{};
+		U32 Repetitions{};
+		U64 Operations{};
+		F64 NsPerOp{};
+		// Requested from `MemoryManager` and from global operator new by the first (cold) run.
+		U64 BytesAllocated{};
+		U64 HeapBytesAllocated{};
+		// Requested from both by one of the timed runs (average).
+		U64 SteadyBytesAllocated{};
+	};
+
+	// Passed to benchmark case: everything outside of `Measure` is setup and is not timed.
+	class BenchmarkContext
+	{
+	public:
+		// Each case shall time at least that many operations (small sizes are repeated).
+		static constexpr U64 MIN_OPERATIONS = 1 << 22;
+
+		BenchmarkContext(const std::string& name, U32 entityCount);
+
+		// Runs `fn`, that performs `operations` operations and leaves the state as it was,
+		// once to warm up (allocations are recorded) and then repeatedly, until at least `MIN_OPERATIONS` operations were timed.
+		template <typename Fn>
+		void Measure(U64 operations, Fn&& fn);
+
+		const BenchmarkResult& GetResult() const { return m_Result; }
+	private:
+		BenchmarkResult m_Result;
+	};
+
+	using BenchmarkFn = void(*)(BenchmarkContext& context, U32 entityCount);
+
+	struct BenchmarkCase
+	{
+		std::string Name;
+		BenchmarkFn Fn;
+	};
+
+	std::vector<BenchmarkCase> GetEcsBenchmarks();
+
+	// Runs every case, whose name contains `filter`, for every size.
+	std::vector<BenchmarkResult> RunBenchmarks(const std::vector<BenchmarkCase>& cases, std::span<const U32> sizes, const std::string& filter);
+	void WriteJson(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+	// Keeps the compiler from optimizing away computations, whose (scalar) results are not used otherwise.
+	template <typename T>
+	void DoNotOptimize(T value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile T sink;
+		sink = value;
+#endif
+	}
+
+	template <typename Fn>
+	void BenchmarkContext::Measure(U64 operations, Fn&& fn)
+	{
+		auto getBytes = []() { return Engine::MemoryManager::GetStats().TotalAllocationsBytes; };
+		U64 bytesBegin = getBytes();
+		U64 heapBytesBegin = GetHeapAllocatedBytes();
+		fn();
+		m_Result.BytesAllocated = getBytes() - bytesBegin;
+		m_Result.HeapBytesAllocated = GetHeapAllocatedBytes() - heapBytesBegin;
+
+		U32 repetitions = static_cast<U32>(std::max<U64>(1, MIN_OPERATIONS / std::max<U64>(1, operations)));
+		bytesBegin = getBytes() + GetHeapAllocatedBytes();
+		auto timeBegin = std::chrono::steady_clock::now();
+		for (U32 i = 0; i < repetitions; i++) fn();
+		auto timeEnd = std::chrono::steady_clock::now();
+		m_Result.SteadyBytesAllocated = (getBytes() + GetHeapAllocatedBytes() - bytesBegin) / repetitions;
+		m_Result.Repetitions = repetitions;
+		m_Result.Operations = operations;
+		m_Result.NsPerOp = std::chrono::duration<F64, std::nano>(timeEnd - timeBegin).count() /
+			(static_cast<F64>(operations) * repetitions);
+	}
+}
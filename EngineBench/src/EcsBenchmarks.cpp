@@ -0,0 +1,123 @@
+#include "Benchmark.h"
+
+#include <Engine/Common/SparseSetPaged.h>
+#include <Engine/ECS/Registry.h>
+#include <Engine/ECS/View.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace Engine;
+
+namespace
+{
+	struct Position { F32 X, Y; };
+	struct Velocity { F32 X, Y; };
+	struct Health { I32 Value; };
+
+	constexpr U32 RANDOM_SEED = 42;
+
+	std::vector<Entity> CreateEntities(Registry& registry, U32 count)
+	{
+		std::vector<Entity> entities(count);
+		for (auto& e : entities) e = registry.CreateEntity();
+		return entities;
+	}
+
+	void CreateDestroy(Bench::BenchmarkContext& context, U32 entityCount)
+	{
+		Registry registry;
+		std::vector<Entity> entities(entityCount);
+		context.Measure(2ull * entityCount, [&]()
+		{
+			for (auto& e : entities) e = registry.CreateEntity();
+			for (auto e : entities) registry.DeleteEntity(e);
+		});
+	}
+
+	void AddRemove(Bench::BenchmarkContext& context, U32 entityCount)
+	{
+		Registry registry;
+		std::vector<Entity> entities = CreateEntities(registry, entityCount);
+		context.Measure(2ull * entityCount, [&]()
+		{
+			for (auto e : entities) registry.Add<Position>(e, 1.0f, 2.0f);
+			for (auto e : entities) registry.Remove<Position>(e);
+		});
+	}
+
+	void ViewSingle(Bench::BenchmarkContext& context, U32 entityCount)
+	{
+		Registry registry;
+		for (auto e : CreateEntities(registry, entityCount)) registry.Add<Position>(e, 1.0f, 2.0f);
+		context.Measure(entityCount, [&]()
+		{
+			F32 sum = 0.0f;
+			View<Position>(registry).Each([&sum](Position& position) { sum += position.X; });
+			Bench::DoNotOptimize(sum);
+		});
+	}
+
+	void ViewTriple(Bench::BenchmarkContext& context, U32 entityCount)
+	{
+		Registry registry;
+		for (auto e : CreateEntities(registry, entityCount))
+		{
+			registry.Add<Position>(e, 1.0f, 2.0f);
+			registry.Add<Velocity>(e, 0.5f, 0.5f);
+			registry.Add<Health>(e, 100);
+		}
+		context.Measure(entityCount, [&]()
+		{
+			View<Position, Velocity, Health>(registry).Each([](Position& position, Velocity& velocity, Health& health)
+			{
+				position.X += velocity.X;
+				position.Y += velocity.Y;
+				health.Value ^= 1;
+			});
+		});
+	}
+
+	void GetRandom(Bench::BenchmarkContext& context, U32 entityCount)
+	{
+		Registry registry;
+		std::vector<Entity> entities = CreateEntities(registry, entityCount);
+		for (auto e : entities) registry.Add<Position>(e, 1.0f, 2.0f);
+		std::shuffle(entities.begin(), entities.end(), std::mt19937(RANDOM_SEED));
+		const Registry& constRegistry = registry;
+		context.Measure(entityCount, [&]()
+		{
+			F32 sum = 0.0f;
+			for (auto e : entities) sum += constRegistry.Get<Position>(e).X;
+			Bench::DoNotOptimize(sum);
+		});
+	}
+
+	void SparseSetPushPop(Bench::BenchmarkContext& context, U32 entityCount)
+	{
+		SparseSetPaged<U32, Entity, EntityIdDecomposer> set;
+		std::vector<Entity> entities(entityCount);
+		for (U32 i = 0; i < entityCount; i++) entities[i] = Entity(i);
+		// Values are popped in the push order, so that every pop swaps with the last one.
+		context.Measure(2ull * entityCount, [&]()
+		{
+			for (auto e : entities) set.Push(e);
+			for (auto e : entities) set.Pop(e);
+		});
+	}
+}
+
+namespace Bench
+{
+	std::vector<BenchmarkCase> GetEcsBenchmarks()
+	{
+		return {
+			{"ECS/CreateDestroy", CreateDestroy},
+			{"ECS/AddRemove", AddRemove},
+			{"ECS/View1", ViewSingle},
+			{"ECS/View3", ViewTriple},
+			{"ECS/GetRandom", GetRandom},
+			{"ECS/SparseSetPushPop", SparseSetPushPop},
+		};
+	}
+}
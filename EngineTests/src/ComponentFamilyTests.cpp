@@ -0,0 +1,47 @@
+#include "enginepch.h"
+#include "Test.h"
+
+#include <Engine/ECS/Registry.h>
+
+using namespace Engine;
+
+namespace
+{
+	// FNV-1a of "Engine::Component::ParentRel", shall not change, as stable ids are persisted.
+	constexpr U64 PARENT_REL_STABLE_ID = 0xa7f4b850dfc4de29ull;
+
+	template <U64 Size>
+	std::string_view Canonicalize(const char (&typeName)[Size])
+	{
+		static std::string canonical;
+		canonical = ComponentFamily::GetCanonicalTypeName<Size>(std::string_view{typeName, Size - 1}).GetView();
+		return canonical;
+	}
+
+	void KnownStableId()
+	{
+		TEST_CHECK(ComponentFamily::STABLE_ID<Component::ParentRel> == PARENT_REL_STABLE_ID)
+		TEST_CHECK(ComponentFamily::STABLE_ID<Component::ParentRel> == Math::HashString("Engine::Component::ParentRel"))
+		TEST_CHECK(ComponentFamily::STABLE_ID<Component::ParentRel> != ComponentFamily::STABLE_ID<Component::ChildRel>)
+	}
+
+	void CanonicalTypeName()
+	{
+		// As MSVC `__FUNCSIG__` spells them.
+		TEST_CHECK(Canonicalize("struct Engine::Component::ParentRel") == "Engine::Component::ParentRel")
+		TEST_CHECK(Canonicalize("class A::B<struct C,enum D,class E<unsigned int> >") == "A::B<C,D,E<unsignedint>>")
+		// As GCC / Clang `__PRETTY_FUNCTION__` spell them.
+		TEST_CHECK(Canonicalize("Engine::Component::ParentRel") == "Engine::Component::ParentRel")
+		TEST_CHECK(Canonicalize("A::B<C, D, E<unsigned int> >") == "A::B<C,D,E<unsignedint>>")
+		// Keywords only at the start of a word.
+		TEST_CHECK(Canonicalize("Subclass::myenum ::Mystruct ") == "Subclass::myenum::Mystruct")
+	}
+}
+
+std::vector<Test::TestCase> Test::GetComponentFamilyTests()
+{
+	return {
+		{"ComponentFamily.KnownStableId", &KnownStableId},
+		{"ComponentFamily.CanonicalTypeName", &CanonicalTypeName},
+	};
+}
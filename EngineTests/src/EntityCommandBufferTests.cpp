@@ -0,0 +1,85 @@
+#include "enginepch.h"
+#include "Test.h"
+
+#include <Engine/ECS/EntityCommandBuffer.h>
+
+using namespace Engine;
+
+namespace
+{
+	struct Score
+	{
+		U32 Value;
+	};
+
+	void RemoveThenAddReplacesComponent()
+	{
+		Registry registry;
+		U32 destroyed = 0;
+		registry.OnDestroy<Score>().Connect([&destroyed](Entity) { destroyed++; });
+		Entity e = registry.CreateEntity();
+		registry.Add<Score>(e, 1u);
+
+		EntityCommandBuffer commandBuffer(registry);
+		commandBuffer.Remove<Score>(e);
+		commandBuffer.Add<Score>(e, 2u);
+		commandBuffer.Playback();
+		TEST_CHECK(registry.Has<Score>(e))
+		TEST_CHECK(registry.Get<Score>(e).Value == 2)
+		TEST_CHECK(registry.GetComponentPool<Score>().GetComponentCount() == 1)
+		TEST_CHECK(destroyed == 1)
+
+		// Addition, followed by removal, leaves no component.
+		commandBuffer.Add<Score>(registry.CreateEntity(), 3u);
+		Entity other = registry.CreateEntity();
+		commandBuffer.Add<Score>(other, 4u);
+		commandBuffer.Remove<Score>(other);
+		commandBuffer.Playback();
+		TEST_CHECK(!registry.Has<Score>(other))
+		TEST_CHECK(registry.GetComponentPool<Score>().GetComponentCount() == 2)
+	}
+
+	void DuplicateRemovalDestroysOnce()
+	{
+		Registry registry;
+		U32 destroyed = 0;
+		registry.OnDestroy<Score>().Connect([&destroyed](Entity) { destroyed++; });
+		Entity e = registry.CreateEntity();
+		registry.Add<Score>(e, 1u);
+
+		EntityCommandBuffer commandBuffer(registry);
+		commandBuffer.Remove<Score>(e);
+		commandBuffer.Remove<Score>(e);
+		commandBuffer.Playback();
+		TEST_CHECK(!registry.Has<Score>(e))
+		TEST_CHECK(destroyed == 1)
+	}
+
+	void DeadTargetsAreIgnored()
+	{
+		Registry registry;
+		Entity alive = registry.CreateEntity();
+		Entity dead = registry.CreateEntity();
+		registry.Add<Score>(dead, 1u);
+
+		EntityCommandBuffer commandBuffer(registry);
+		commandBuffer.Add<Score>(dead, 2u);
+		commandBuffer.Remove<Score>(dead);
+		commandBuffer.Add<Score>(alive, 3u);
+		// Deleted after recording, but before playback.
+		registry.DeleteEntity(dead);
+		commandBuffer.Playback();
+		TEST_CHECK(!registry.IsEntityExists(dead))
+		TEST_CHECK(registry.Get<Score>(alive).Value == 3)
+		TEST_CHECK(registry.GetComponentPool<Score>().GetComponentCount() == 1)
+	}
+}
+
+std::vector<Test::TestCase> Test::GetEntityCommandBufferTests()
+{
+	return {
+		{"EntityCommandBuffer.RemoveThenAddReplacesComponent", &RemoveThenAddReplacesComponent},
+		{"EntityCommandBuffer.DuplicateRemovalDestroysOnce", &DuplicateRemovalDestroysOnce},
+		{"EntityCommandBuffer.DeadTargetsAreIgnored", &DeadTargetsAreIgnored},
+	};
+}
@@ -0,0 +1,44 @@
+#include "enginepch.h"
+#include "Test.h"
+
+#include <Engine/Memory/MemoryResource.h>
+
+using namespace Engine;
+
+namespace
+{
+	void StackTryAllocAligned()
+	{
+		StackAllocator stack(256);
+		void* first = stack.TryAllocAligned(100, 16);
+		TEST_CHECK(first != nullptr && reinterpret_cast<U64>(first) % 16 == 0)
+		U64 marker = stack.GetMarker();
+		TEST_CHECK(stack.TryAllocAligned(200, 16) == nullptr)
+		TEST_CHECK(stack.GetMarker() == marker)
+		TEST_CHECK(stack.TryAllocAligned(100, 16) != nullptr)
+	}
+
+	void StackResourceFallsBackToUpstream()
+	{
+		StackAllocator stack(256);
+		StackMemoryResource resource(stack);
+		std::pmr::vector<U64> small(&resource);
+		small.reserve(8);
+		TEST_CHECK(stack.Belongs(small.data()))
+		// Does not fit, served by `MemoryManager`.
+		std::pmr::vector<U64> large(&resource);
+		large.resize(1024, 7);
+		TEST_CHECK(!stack.Belongs(large.data()))
+		TEST_CHECK(large.back() == 7)
+		small.push_back(1);
+		TEST_CHECK(stack.Belongs(small.data()))
+	}
+}
+
+std::vector<Test::TestCase> Test::GetMemoryTests()
+{
+	return {
+		{"Memory.StackTryAllocAligned", &StackTryAllocAligned},
+		{"Memory.StackResourceFallsBackToUpstream", &StackResourceFallsBackToUpstream},
+	};
+}
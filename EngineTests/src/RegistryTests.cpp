@@ -0,0 +1,131 @@
+#include "enginepch.h"
+#include "Test.h"
+
+#include <Engine/ECS/Registry.h>
+
+using namespace Engine;
+
+namespace
+{
+	struct Health
+	{
+		F32 Value;
+	};
+
+	void ShrinkToFitKeepsStaleHandlesDead()
+	{
+		Registry registry;
+		std::vector<Entity> alive;
+		for (U32 i = 0; i < 4; i++) alive.push_back(registry.CreateEntity());
+		// Indices past the last alive one go through a few generations, then are forgotten by the shrink.
+		std::vector<Entity> stale;
+		for (U32 cycle = 0; cycle < 3; cycle++)
+		{
+			std::vector<Entity> trailing;
+			for (U32 i = 0; i < 8; i++) trailing.push_back(registry.CreateEntity());
+			for (auto e : trailing) registry.DeleteEntity(e);
+			stale.insert(stale.end(), trailing.begin(), trailing.end());
+		}
+		registry.ShrinkToFit();
+
+		std::vector<Entity> created;
+		for (U32 i = 0; i < 8; i++) created.push_back(registry.CreateEntity());
+		std::vector<Entity> batch = registry.CreateEntities(8, "batch");
+		created.insert(created.end(), batch.begin(), batch.end());
+		for (auto e : stale) TEST_CHECK(!registry.IsEntityExists(e))
+		for (auto e : alive) TEST_CHECK(registry.IsEntityExists(e))
+		for (auto e : created)
+		{
+			TEST_CHECK(registry.IsEntityExists(e))
+			for (auto s : stale) TEST_CHECK(e != s)
+		}
+	}
+
+	void ClearKeepsStaleHandlesDead()
+	{
+		Registry registry;
+		std::vector<Entity> stale;
+		for (U32 i = 0; i < 8; i++) stale.push_back(registry.CreateEntity());
+		for (U32 i = 0; i < 4; i++) registry.DeleteEntity(stale[i]);
+		registry.Clear();
+
+		std::vector<Entity> created;
+		for (U32 i = 0; i < 8; i++) created.push_back(registry.CreateEntity());
+		for (auto e : stale) TEST_CHECK(!registry.IsEntityExists(e))
+		for (auto e : created) TEST_CHECK(registry.IsEntityExists(e))
+	}
+
+	void LayoutVersionTracksDenseChanges()
+	{
+		Registry registry;
+		std::vector<Entity> entities;
+		for (U32 i = 0; i < 8; i++)
+		{
+			entities.push_back(registry.CreateEntity());
+			registry.Add<U32>(entities.back(), 8 - i);
+		}
+		const auto& pool = registry.GetComponentPool<U32>();
+		auto byValue = [](U32 a, U32 b) { return a < b; };
+
+		U32 version = pool.GetLayoutVersion();
+		registry.Sort<U32>(byValue);
+		TEST_CHECK(pool.GetLayoutVersion() != version)
+		// Sorted pool is not touched, writes through `Get` are not layout changes.
+		version = pool.GetLayoutVersion();
+		registry.Sort<U32>(byValue);
+		registry.Get<U32>(entities[0]) = 1;
+		TEST_CHECK(pool.GetLayoutVersion() == version)
+
+		registry.Remove<U32>(entities[3]);
+		TEST_CHECK(pool.GetLayoutVersion() != version)
+		version = pool.GetLayoutVersion();
+		registry.Add<U32>(entities[3], 0u);
+		TEST_CHECK(pool.GetLayoutVersion() != version)
+	}
+
+	void CreateEntitiesSignsBeforeObservers()
+	{
+		Registry registry;
+		U32 constructed = 0;
+		bool isSigned = true;
+		registry.OnConstruct<Health>().Connect([&](Entity e)
+		{
+			constructed++;
+			isSigned = isSigned && registry.Has<Health>(e) && registry.Has<Component::Name>(e);
+		});
+		registry.CreateEntities(4, "batch", Health{1.0f});
+		TEST_CHECK(constructed == 4)
+		TEST_CHECK(isSigned)
+	}
+
+	void CreateEntitiesReusesFreeSlots()
+	{
+		using Transform = Component::LocalToWorldTransform2D;
+		Registry registry;
+		std::vector<Entity> entities = registry.CreateEntities(4, "batch", Transform{});
+		registry.Remove<Transform>(entities[1]);
+		registry.Remove<Transform>(entities[2]);
+		const auto& pool = registry.GetComponentPool<Transform>();
+		TEST_CHECK(pool.GetTombstoneCount() == 2)
+
+		std::vector<Entity> created = registry.CreateEntities(3, "batch", Transform{});
+		TEST_CHECK(pool.GetTombstoneCount() == 0)
+		TEST_CHECK(pool.GetComponentCount() == 5)
+		for (auto e : created)
+		{
+			TEST_CHECK(registry.Has<Transform>(e))
+			TEST_CHECK(pool.GetDenseEntities()[pool.TryGetComponentIndex(e)] == e)
+		}
+	}
+}
+
+std::vector<Test::TestCase> Test::GetRegistryTests()
+{
+	return {
+		{"Registry.ShrinkToFitKeepsStaleHandlesDead", &ShrinkToFitKeepsStaleHandlesDead},
+		{"Registry.ClearKeepsStaleHandlesDead", &ClearKeepsStaleHandlesDead},
+		{"Registry.LayoutVersionTracksDenseChanges", &LayoutVersionTracksDenseChanges},
+		{"Registry.CreateEntitiesSignsBeforeObservers", &CreateEntitiesSignsBeforeObservers},
+		{"Registry.CreateEntitiesReusesFreeSlots", &CreateEntitiesReusesFreeSlots},
+	};
+}
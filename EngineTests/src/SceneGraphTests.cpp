@@ -0,0 +1,315 @@
+#include "enginepch.h"
+#include "Test.h"
+
+#include <Engine/ECS/Registry.h>
+#include <Engine/ECS/View.h>
+#include <Engine/Scene/SceneGraph.h>
+
+#include <random>
+
+using namespace Engine;
+
+namespace
+{
+	constexpr U32 RANDOM_SEED = 42;
+
+	Entity CreateNode(Registry& registry)
+	{
+		Entity e = registry.CreateEntity();
+		registry.Add<Component::LocalToWorldTransform2D>(e);
+		return e;
+	}
+
+	// Hierarchy bookkeeping of `SceneUtils::AddChild / RemoveChild / DeleteEntity` (those need a full scene).
+	void RemoveChild(Registry& registry, SceneGraph& graph, Entity child)
+	{
+		auto& parentRel = registry.Get<Component::ParentRel>(child);
+		Entity parent = parentRel.Parent;
+		auto& childRel = registry.Get<Component::ChildRel>(parent);
+		if (parentRel.Prev != NULL_ENTITY) registry.Get<Component::ParentRel>(parentRel.Prev).Next = parentRel.Next;
+		if (parentRel.Next != NULL_ENTITY) registry.Get<Component::ParentRel>(parentRel.Next).Prev = parentRel.Prev;
+		if (child == childRel.First) childRel.First = parentRel.Next;
+		childRel.ChildrenCount--;
+
+		graph.OnChildRemoving(child);
+		registry.Remove<Component::ParentRel>(child);
+		registry.Remove<Component::LocalToParentTransform2D>(child);
+		if (childRel.ChildrenCount == 0) registry.Remove<Component::ChildRel>(parent);
+	}
+
+	void AddChild(Registry& registry, SceneGraph& graph, Entity parent, Entity child)
+	{
+		if (registry.Has<Component::ParentRel>(child)) RemoveChild(registry, graph, child);
+		if (!registry.Has<Component::ChildRel>(parent)) registry.Add<Component::ChildRel>(parent);
+		auto& childRel = registry.Get<Component::ChildRel>(parent);
+		auto& parentRel = registry.Add<Component::ParentRel>(child);
+		parentRel.Parent = parent;
+		if (childRel.ChildrenCount != 0)
+		{
+			registry.Get<Component::ParentRel>(childRel.First).Prev = child;
+			parentRel.Next = childRel.First;
+		}
+		childRel.First = child;
+		childRel.ChildrenCount++;
+		registry.Add<Component::LocalToParentTransform2D>(child);
+
+		graph.OnChildAdded(child);
+	}
+
+	void DeleteEntity(Registry& registry, SceneGraph& graph, Entity entity)
+	{
+		if (registry.Has<Component::ParentRel>(entity)) RemoveChild(registry, graph, entity);
+		graph.DeleteDescendants(entity);
+		registry.DeleteEntity(entity);
+	}
+
+	bool IsDescendant(Registry& registry, Entity entity, Entity ancestor)
+	{
+		while (registry.Has<Component::ParentRel>(entity))
+		{
+			entity = registry.Get<Component::ParentRel>(entity).Parent;
+			if (entity == ancestor) return true;
+		}
+		return false;
+	}
+
+	U32 CountDescendants(Registry& registry, Entity entity)
+	{
+		if (!registry.Has<Component::ChildRel>(entity)) return 0;
+		U32 count = 0;
+		Entity child = registry.Get<Component::ChildRel>(entity).First;
+		while (child != NULL_ENTITY)
+		{
+			count += 1 + CountDescendants(registry, child);
+			child = registry.Get<Component::ParentRel>(child).Next;
+		}
+		return count;
+	}
+
+	// Checks `ParentRel::ParentIndex` and `ParentRel::DescendantCount` against `ChildRel / ParentRel` links,
+	// and that every subtree is a contiguous range of the pool.
+	void CheckFlattenedHierarchy(Registry& registry, const SceneGraph& graph)
+	{
+		if (!registry.IsComponentExists(ComponentFamily::TYPE<Component::ParentRel>)) return;
+		const auto& pool = registry.GetComponentPool<Component::ParentRel>();
+		const auto& entities = pool.GetDenseEntities();
+		U32 count = pool.GetComponentCount();
+		for (U32 i = 0; i < count; i++)
+		{
+			const auto& parentRel = registry.Get<Component::ParentRel>(entities[i]);
+			U32 parentIndex = pool.TryGetComponentIndex(parentRel.Parent);
+			if (parentIndex == pool.GetNullIndex())
+			{
+				TEST_CHECK(parentRel.ParentIndex == -1)
+			}
+			else
+			{
+				TEST_CHECK(parentRel.ParentIndex == static_cast<I32>(parentIndex))
+				TEST_CHECK(parentIndex < i)
+			}
+			U32 descendantCount = CountDescendants(registry, entities[i]);
+			TEST_CHECK(parentRel.DescendantCount == descendantCount)
+			TEST_CHECK(i + 1 + descendantCount <= count)
+			for (U32 j = i + 1; j < std::min(count, i + 1 + descendantCount); j++)
+			{
+				TEST_CHECK(IsDescendant(registry, entities[j], entities[i]))
+			}
+		}
+		for (auto e : View<Component::ChildRel>(registry))
+		{
+			if (registry.Has<Component::ParentRel>(e)) continue;
+			auto [begin, end] = graph.GetDescendantsRange(e);
+			TEST_CHECK(end - begin == CountDescendants(registry, e))
+			for (U32 i = begin; i < end; i++) TEST_CHECK(IsDescendant(registry, entities[i], e))
+		}
+	}
+
+	void AddChildren()
+	{
+		Registry registry;
+		SceneGraph graph(registry);
+		graph.SetFlattenedHierarchy(true);
+		std::vector<Entity> nodes(8);
+		for (auto& e : nodes) e = CreateNode(registry);
+
+		AddChild(registry, graph, nodes[0], nodes[1]);
+		CheckFlattenedHierarchy(registry, graph);
+		AddChild(registry, graph, nodes[0], nodes[2]);
+		CheckFlattenedHierarchy(registry, graph);
+		AddChild(registry, graph, nodes[1], nodes[3]);
+		CheckFlattenedHierarchy(registry, graph);
+		AddChild(registry, graph, nodes[2], nodes[4]);
+		CheckFlattenedHierarchy(registry, graph);
+		AddChild(registry, graph, nodes[1], nodes[5]);
+		CheckFlattenedHierarchy(registry, graph);
+		// Tree, that is attached as a whole.
+		AddChild(registry, graph, nodes[6], nodes[7]);
+		AddChild(registry, graph, nodes[3], nodes[6]);
+		CheckFlattenedHierarchy(registry, graph);
+
+		auto [begin, end] = graph.GetDescendantsRange(nodes[0]);
+		TEST_CHECK(begin == 0 && end == 7)
+		TEST_CHECK(registry.Get<Component::ParentRel>(nodes[1]).DescendantCount == 4)
+	}
+
+	void RemoveChildren()
+	{
+		Registry registry;
+		SceneGraph graph(registry);
+		graph.SetFlattenedHierarchy(true);
+		std::vector<Entity> nodes(8);
+		for (auto& e : nodes) e = CreateNode(registry);
+		for (U32 i = 1; i < nodes.size(); i++) AddChild(registry, graph, nodes[(i - 1) / 2], nodes[i]);
+		CheckFlattenedHierarchy(registry, graph);
+
+		// Inner node (with subtree), leaf, and the last child of the parent.
+		RemoveChild(registry, graph, nodes[1]);
+		CheckFlattenedHierarchy(registry, graph);
+		TEST_CHECK(!registry.Has<Component::ParentRel>(nodes[1]))
+		auto [begin, end] = graph.GetDescendantsRange(nodes[1]);
+		TEST_CHECK(end - begin == 3)
+		RemoveChild(registry, graph, nodes[5]);
+		CheckFlattenedHierarchy(registry, graph);
+		RemoveChild(registry, graph, nodes[6]);
+		CheckFlattenedHierarchy(registry, graph);
+		TEST_CHECK(!registry.Has<Component::ChildRel>(nodes[2]))
+	}
+
+	void Reparent()
+	{
+		Registry registry;
+		SceneGraph graph(registry);
+		graph.SetFlattenedHierarchy(true);
+		std::vector<Entity> nodes(10);
+		for (auto& e : nodes) e = CreateNode(registry);
+		// Two trees: 0 -> (1 -> (2, 3), 4) and 5 -> (6 -> 7, 8 -> 9).
+		AddChild(registry, graph, nodes[0], nodes[1]);
+		AddChild(registry, graph, nodes[1], nodes[2]);
+		AddChild(registry, graph, nodes[1], nodes[3]);
+		AddChild(registry, graph, nodes[0], nodes[4]);
+		AddChild(registry, graph, nodes[5], nodes[6]);
+		AddChild(registry, graph, nodes[6], nodes[7]);
+		AddChild(registry, graph, nodes[5], nodes[8]);
+		AddChild(registry, graph, nodes[8], nodes[9]);
+		CheckFlattenedHierarchy(registry, graph);
+
+		// Within the tree, to the other tree, and a top-level tree under a leaf.
+		AddChild(registry, graph, nodes[4], nodes[1]);
+		CheckFlattenedHierarchy(registry, graph);
+		AddChild(registry, graph, nodes[7], nodes[1]);
+		CheckFlattenedHierarchy(registry, graph);
+		AddChild(registry, graph, nodes[9], nodes[0]);
+		CheckFlattenedHierarchy(registry, graph);
+		TEST_CHECK(registry.Get<Component::ParentRel>(nodes[6]).DescendantCount == 4)
+		TEST_CHECK(registry.Get<Component::ParentRel>(nodes[8]).DescendantCount == 3)
+	}
+
+	void DeleteSubtrees()
+	{
+		Registry registry;
+		SceneGraph graph(registry);
+		graph.SetFlattenedHierarchy(true);
+		std::vector<Entity> nodes(12);
+		for (auto& e : nodes) e = CreateNode(registry);
+		for (U32 i = 1; i < 8; i++) AddChild(registry, graph, nodes[(i - 1) / 2], nodes[i]);
+		for (U32 i = 9; i < 12; i++) AddChild(registry, graph, nodes[8], nodes[i]);
+		CheckFlattenedHierarchy(registry, graph);
+
+		// Nested subtree: 2 -> (5, 6).
+		DeleteEntity(registry, graph, nodes[2]);
+		CheckFlattenedHierarchy(registry, graph);
+		for (U32 i : {2, 5, 6}) TEST_CHECK(!registry.IsEntityExists(nodes[i]))
+		for (U32 i : {0, 1, 3, 4}) TEST_CHECK(registry.IsEntityExists(nodes[i]))
+		// Top-level tree.
+		DeleteEntity(registry, graph, nodes[0]);
+		CheckFlattenedHierarchy(registry, graph);
+		for (U32 i = 0; i < 8; i++) TEST_CHECK(!registry.IsEntityExists(nodes[i]))
+		for (U32 i = 8; i < 12; i++) TEST_CHECK(registry.IsEntityExists(nodes[i]))
+		TEST_CHECK(registry.GetComponentPool<Component::ParentRel>().GetComponentCount() == 3)
+	}
+
+	void RandomOperations()
+	{
+		Registry registry;
+		SceneGraph graph(registry);
+		graph.SetFlattenedHierarchy(true);
+		std::mt19937 random(RANDOM_SEED);
+		std::vector<Entity> nodes(48);
+		for (auto& e : nodes) e = CreateNode(registry);
+		for (U32 step = 0; step < 1500; step++)
+		{
+			Entity a = nodes[random() % nodes.size()];
+			Entity b = nodes[random() % nodes.size()];
+			U32 operation = random() % 8;
+			if (operation < 5)
+			{
+				if (a != b && !IsDescendant(registry, a, b)) AddChild(registry, graph, a, b);
+			}
+			else if (operation < 7)
+			{
+				if (registry.Has<Component::ParentRel>(b)) RemoveChild(registry, graph, b);
+			}
+			else
+			{
+				DeleteEntity(registry, graph, b);
+				for (auto& e : nodes) if (!registry.IsEntityExists(e)) e = CreateNode(registry);
+			}
+			CheckFlattenedHierarchy(registry, graph);
+		}
+	}
+
+	void FlattenedTransformsMatchHierarchy()
+	{
+		Registry registry;
+		SceneGraph graph(registry);
+		graph.SetFlattenedHierarchy(true);
+		std::mt19937 random(RANDOM_SEED);
+		std::uniform_real_distribution<F32> distribution(-1.0f, 1.0f);
+		std::vector<Entity> nodes(64);
+		for (auto& e : nodes) e = CreateNode(registry);
+		for (U32 i = 1; i < nodes.size(); i++)
+		{
+			if (random() % 8 == 0) continue;
+			AddChild(registry, graph, nodes[random() % i], nodes[i]);
+		}
+		for (auto e : nodes)
+		{
+			glm::vec2 position = {distribution(random), distribution(random)};
+			glm::vec2 scale = glm::vec2{1.5f} + glm::vec2{distribution(random), distribution(random)};
+			F32 rotation = distribution(random) * 3.0f;
+			if (registry.Has<Component::LocalToParentTransform2D>(e))
+			{
+				auto& tf = registry.Get<Component::LocalToParentTransform2D>(e);
+				tf.Position = position; tf.Scale = scale; tf.Rotation = Rotation(rotation);
+			}
+			else
+			{
+				registry.Get<Component::LocalToWorldTransform2D>(e) = Component::LocalToWorldTransform2D(position, scale, rotation);
+			}
+		}
+
+		graph.OnUpdate();
+		std::vector<Component::LocalToWorldTransform2D> flattened;
+		for (auto e : nodes) flattened.push_back(registry.Get<Component::LocalToWorldTransform2D>(e));
+		graph.SetFlattenedHierarchy(false);
+		graph.OnUpdate();
+		for (U32 i = 0; i < nodes.size(); i++)
+		{
+			auto& tf = registry.Get<Component::LocalToWorldTransform2D>(nodes[i]);
+			TEST_CHECK(glm::length(tf.Position - flattened[i].Position) < 1e-4f)
+			TEST_CHECK(glm::length(tf.Scale - flattened[i].Scale) < 1e-4f)
+		}
+	}
+}
+
+std::vector<Test::TestCase> Test::GetSceneGraphTests()
+{
+	return {
+		{"SceneGraph.AddChildren", &AddChildren},
+		{"SceneGraph.RemoveChildren", &RemoveChildren},
+		{"SceneGraph.Reparent", &Reparent},
+		{"SceneGraph.DeleteSubtrees", &DeleteSubtrees},
+		{"SceneGraph.RandomOperations", &RandomOperations},
+		{"SceneGraph.FlattenedTransformsMatchHierarchy", &FlattenedTransformsMatchHierarchy},
+	};
+}
@@ -0,0 +1,126 @@
+#include "enginepch.h"
+#include "Test.h"
+
+#include <Engine/ECS/Registry.h>
+#include <Engine/ECS/View.h>
+
+using namespace Engine;
+
+namespace
+{
+	using Transform = Component::GemWarsTransform2D;
+	using TransformPage = SoaPage<Transform>;
+
+	Transform MakeTransform(U32 i)
+	{
+		return Transform(glm::vec3{F32(i), F32(i) * 2.0f, 1.0f}, glm::vec2{F32(i) + 0.5f}, F32(i) * 0.25f);
+	}
+
+	bool IsEqual(const Transform& a, const Transform& b)
+	{
+		return a.Position.x == b.Position.x && a.Position.y == b.Position.y && a.Position.z == b.Position.z &&
+			a.Scale.x == b.Scale.x && a.Scale.y == b.Scale.y && a.Rotation == b.Rotation;
+	}
+
+	void LoadStoreCopy()
+	{
+		std::vector<U64> storage(TransformPage::GetFieldOffset<TransformPage::FIELD_COUNT>() / sizeof(U64));
+		U8* page = reinterpret_cast<U8*>(storage.data());
+		for (U32 i = 0; i < SPARSE_SET_PAGE_SIZE; i++) TransformPage::Store(page, i, MakeTransform(i));
+		for (U32 i = 0; i < SPARSE_SET_PAGE_SIZE; i++) TEST_CHECK(IsEqual(TransformPage::Load(page, i), MakeTransform(i)))
+		// Fields are separate arrays.
+		const F32* rotations = TransformPage::GetFieldArray<2>(page);
+		TEST_CHECK(rotations[7] == MakeTransform(7).Rotation)
+		TEST_CHECK(reinterpret_cast<const U8*>(rotations) - page == SPARSE_SET_PAGE_SIZE * (sizeof(glm::vec3) + sizeof(glm::vec2)))
+
+		TransformPage::Copy(page, 3, page, SPARSE_SET_PAGE_SIZE - 1);
+		TEST_CHECK(IsEqual(TransformPage::Load(page, SPARSE_SET_PAGE_SIZE - 1), MakeTransform(3)))
+		TEST_CHECK(IsEqual(TransformPage::Load(page, SPARSE_SET_PAGE_SIZE - 2), MakeTransform(SPARSE_SET_PAGE_SIZE - 2)))
+
+		SoaRef<Transform> ref(page, 5);
+		ref = MakeTransform(42);
+		TEST_CHECK(IsEqual(ref, MakeTransform(42)))
+		ref.Field<&Transform::Rotation>() = 1.0f;
+		TEST_CHECK(TransformPage::Load(page, 5).Rotation == 1.0f)
+		TEST_CHECK(IsEqual(TransformPage::Load(page, 4), MakeTransform(4)))
+	}
+
+	void SwapRemove()
+	{
+		Registry registry;
+		std::vector<Entity> entities;
+		const U32 count = SPARSE_SET_PAGE_SIZE + 100;
+		for (U32 i = 0; i < count; i++)
+		{
+			entities.push_back(registry.CreateEntity());
+			registry.Add<Transform>(entities.back(), MakeTransform(i));
+		}
+		// Last, first, and ones from different pages (the last one is swapped in).
+		std::vector<U32> removed = {count - 1, 0, 10, SPARSE_SET_PAGE_SIZE + 5, SPARSE_SET_PAGE_SIZE - 1};
+		for (U32 i : removed) registry.Remove<Transform>(entities[i]);
+
+		const auto& pool = registry.GetComponentPool<Transform>();
+		TEST_CHECK(pool.GetComponentCount() == count - removed.size())
+		for (U32 i = 0; i < count; i++)
+		{
+			bool isRemoved = std::ranges::find(removed, i) != removed.end();
+			TEST_CHECK(registry.Has<Transform>(entities[i]) != isRemoved)
+			if (!isRemoved)
+			{
+				TEST_CHECK(IsEqual(registry.Get<Transform>(entities[i]), MakeTransform(i)))
+			}
+		}
+	}
+
+	void FieldSpanIteration()
+	{
+		Registry registry;
+		const U32 count = 2 * SPARSE_SET_PAGE_SIZE + 3;
+		std::vector<Entity> entities = registry.CreateEntities(count, "entity", MakeTransform(1));
+		for (U32 i = 0; i < count; i++) registry.Get<Transform>(entities[i]) = MakeTransform(i);
+
+		const auto& pool = registry.GetComponentPool<Transform>();
+		const auto& denseEntities = pool.GetDenseEntities();
+		TEST_CHECK(pool.GetPageCount() == 3)
+		U32 visited = 0;
+		for (U32 page = 0; page < pool.GetPageCount(); page++)
+		{
+			std::span<glm::vec3> positions = registry.GetFieldSpan<&Transform::Position>(page);
+			std::span<F32> rotations = registry.GetFieldSpan<&Transform::Rotation>(page);
+			TEST_CHECK(positions.size() == rotations.size())
+			for (U32 i = 0; i < positions.size(); i++)
+			{
+				Entity e = denseEntities[page * SPARSE_SET_PAGE_SIZE + i];
+				TEST_CHECK(positions[i].x == registry.Get<Transform>(e).Field<&Transform::Position>().x)
+				positions[i].x += 1.0f;
+				rotations[i] = -1.0f;
+			}
+			visited += static_cast<U32>(positions.size());
+		}
+		TEST_CHECK(visited == count)
+
+		for (U32 i = 0; i < count; i++)
+		{
+			Transform expected = MakeTransform(i);
+			expected.Position.x += 1.0f;
+			expected.Rotation = -1.0f;
+			TEST_CHECK(IsEqual(registry.Get<Transform>(entities[i]), expected))
+		}
+
+		// Views pass proxies, writes through them are visible to spans.
+		View<Transform>(registry).Each([](auto tf) { tf.template Field<&Transform::Rotation>() = 2.0f; });
+		for (U32 page = 0; page < pool.GetPageCount(); page++)
+		{
+			for (F32 rotation : registry.GetFieldSpan<&Transform::Rotation>(page)) TEST_CHECK(rotation == 2.0f)
+		}
+	}
+}
+
+std::vector<Test::TestCase> Test::GetSoaTests()
+{
+	return {
+		{"Soa.LoadStoreCopy", &LoadStoreCopy},
+		{"Soa.SwapRemove", &SwapRemove},
+		{"Soa.FieldSpanIteration", &FieldSpanIteration},
+	};
+}
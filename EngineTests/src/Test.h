@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Engine/Core/Types.h>
+
+#include <string>
+#include <vector>
+
+using namespace Engine::Types;
+
+// Does not stop the test, so that every failed check of it is reported.
+#define TEST_CHECK(x) if (x) {} else { Test::ReportFailure(#x, __FILE__, __LINE__); }
+
+namespace Test
+{
+	using TestFn = void(*)();
+
+	struct TestCase
+	{
+		std::string Name;
+		TestFn Fn;
+	};
+
+	// Marks the running test as failed.
+	void ReportFailure(const char* expression, const char* file, U32 line);
+
+	std::vector<TestCase> GetComponentFamilyTests();
+	std::vector<TestCase> GetEntityCommandBufferTests();
+	std::vector<TestCase> GetMemoryTests();
+	std::vector<TestCase> GetRegistryTests();
+	std::vector<TestCase> GetSceneGraphTests();
+	std::vector<TestCase> GetSoaTests();
+
+	// Runs every case, whose name contains `filter`, returns the number of failed cases.
+	U32 RunTests(const std::vector<TestCase>& cases, const std::string& filter);
+}
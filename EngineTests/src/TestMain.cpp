@@ -0,0 +1,66 @@
+#include "enginepch.h"
+#include "Test.h"
+
+#include <Engine/Core/Log.h>
+#include <Engine/Memory/FrameAllocator.h>
+#include <Engine/Memory/MemoryManager.h>
+
+#include <iostream>
+
+namespace
+{
+	U32 s_FailedChecks = 0;
+}
+
+void Test::ReportFailure(const char* expression, const char* file, U32 line)
+{
+	std::cerr << "\t" << file << ":" << line << ": check failed: " << expression << "\n";
+	s_FailedChecks++;
+}
+
+U32 Test::RunTests(const std::vector<TestCase>& cases, const std::string& filter)
+{
+	U32 failedCases = 0;
+	for (auto& test : cases)
+	{
+		if (test.Name.find(filter) == std::string::npos) continue;
+		U32 failedChecks = s_FailedChecks;
+		test.Fn();
+		bool isFailed = s_FailedChecks != failedChecks;
+		std::cout << (isFailed ? "[FAIL] " : "[ OK ] ") << test.Name << "\n";
+		if (isFailed) failedCases++;
+	}
+	return failedCases;
+}
+
+// Usage: EngineTests [--filter <substring>], exit code is the number of failed tests.
+int main(int argc, char** argv)
+{
+	std::string filter;
+	for (I32 i = 1; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+		if (option == "--filter") filter = argv[i + 1];
+		else
+		{
+			std::cerr << "Unknown option: " << option << "\n";
+			return 1;
+		}
+	}
+
+	Engine::Log::Init();
+	Engine::MemoryManager::Init();
+	Engine::FrameAllocator::Init();
+
+	std::vector<Test::TestCase> cases = Test::GetComponentFamilyTests();
+	for (auto& test : Test::GetEntityCommandBufferTests()) cases.push_back(test);
+	for (auto& test : Test::GetMemoryTests()) cases.push_back(test);
+	for (auto& test : Test::GetRegistryTests()) cases.push_back(test);
+	for (auto& test : Test::GetSceneGraphTests()) cases.push_back(test);
+	for (auto& test : Test::GetSoaTests()) cases.push_back(test);
+	U32 failedCases = Test::RunTests(cases, filter);
+	std::cout << failedCases << " failed\n";
+
+	Engine::FrameAllocator::ShutDown();
+	return static_cast<I32>(failedCases);
+}
@@ -4,6 +4,14 @@
 
 #include <ranges>
 
+namespace
+{
+    // `GemWarsTransform2D` is stored as structure of arrays (see `SoaLayout`), single fields are accessed by
+    // `SoaRef::Field`.
+    constexpr auto TRANSFORM_POSITION = &Component::GemWarsTransform2D::Position;
+    constexpr auto TRANSFORM_ROTATION = &Component::GemWarsTransform2D::Rotation;
+}
+
 void GemWarsExample::OnAttach()
 {
     m_Tileset = Texture::LoadTextureFromFile("assets/textures/cavesofgallet_tiles.png");
@@ -21,6 +29,7 @@ void GemWarsExample::OnAttach()
     SetBounds();
 
     SpawnPlayer();
+    InitSystems();
     m_Font = Font::ReadFontFromFile("assets/fonts/Roboto-Thin.ttf");
     FrameBuffer::Spec spec;
     spec.Width = camera->GetViewportWidth();
@@ -46,11 +55,7 @@ void GemWarsExample::OnUpdate()
     sUserInput();
     if (m_IsRunning)
     {
-        sMovement(dt);
-        sCollision();
-        sEnemySpawner();
-        sParticleUpdate();
-        sSpecialAbility();
+        m_Systems.Run(dt);
         // Let's hope player doesn't play for more than 35 trillion years.
         m_CurrentFrame++;
     }
@@ -71,6 +76,24 @@ void GemWarsExample::OnImguiUpdate()
 }
 
 
+void GemWarsExample::InitSystems()
+{
+    // Spawns are recorded into command buffer of the graph.
+    m_Systems.AddSystem("Movement", [this](F32 dt) { sMovement(dt); })
+        .Reads<Component::GemWarsInput>()
+        .Writes<Component::GemWarsTransform2D, Component::GemWarsRigidBody2D>();
+    // Deletes and respawns player, pauses the game.
+    m_Systems.AddSystem("Collision", [this](F32) { sCollision(); }).Exclusive();
+    m_Systems.AddSystem("EnemySpawner", [this](F32) { sEnemySpawner(); })
+        .Reads<Component::GemWarsTransform2D, Component::GemWarsRigidBody2D>();
+    m_Systems.AddSystem("ParticleUpdate", [this](F32) { sParticleUpdate(); })
+        .Reads<Component::GemWarsParticleTag>()
+        .Writes<Component::GemWarsLifeSpan, Component::GemWarsMesh2D>();
+    m_Systems.AddSystem("SpecialAbility", [this](F32) { sSpecialAbility(); })
+        .Reads<Component::GemWarsInput, Component::GemWarsTransform2D, Component::GemWarsRigidBody2D>()
+        .Writes<Component::GemWarsSpecialAbility>();
+}
+
 void GemWarsExample::SpawnPlayer()
 {
     Entity entity = m_Registry.CreateEntity("player");
@@ -98,10 +121,12 @@ void GemWarsExample::sEnemySpawner()
     I32 spawnThreshold = 2 * 60;
     if (m_CurrentFrame - m_LastEnemySpawnTime > spawnThreshold)
     {
+        EntityCommandBuffer& commandBuffer = m_Systems.GetCommandBuffer();
+        glm::vec2 playerPosition = glm::vec2(m_Registry.Get<Component::GemWarsTransform2D>(m_Player).Field<TRANSFORM_POSITION>());
+        F32 playerRadius = m_Registry.Get<Component::GemWarsRigidBody2D>(m_Player).CollisionRadius;
         U32 enemiesToSpawn = Random::UInt32(1, 3);
         for (U32 i = 0; i < enemiesToSpawn; i++)
         {
-            Entity enemy = m_Registry.CreateEntity("enemy");
             F32 enemyRadius = Random::Float(0.15f, 0.45f);
             glm::vec2 allowedXRegion = glm::vec2{
                 m_Bounds.BottomLeft.x + enemyRadius, m_Bounds.TopRight.x - enemyRadius
@@ -109,24 +134,27 @@ void GemWarsExample::sEnemySpawner()
             glm::vec2 allowedYRegion = glm::vec2{
                 m_Bounds.BottomLeft.y + enemyRadius, m_Bounds.TopRight.y - enemyRadius
             };
-            glm::vec2 enemyPosition = glm::vec2(Random::Float(allowedXRegion.x, allowedXRegion.y),
-                                                Random::Float(allowedYRegion.x, allowedYRegion.y));
-            m_Registry.Add<Component::GemWarsTransform2D>(enemy, enemyPosition, glm::vec2{enemyRadius}, 0.0f);
-            m_Registry.Add<Component::GemWarsRigidBody2D>(enemy, enemyRadius, Random::Float(2.0, 5.0f),
-                                                              Random::Float(glm::radians(30.0f), glm::radians(90.0f)));
-            while (Collide(enemy, m_Player))
+            F32 minDistance = (enemyRadius + playerRadius) * (enemyRadius + playerRadius);
+            glm::vec2 enemyPosition;
+            do
             {
-                m_Registry.Get<Component::GemWarsTransform2D>(enemy).Position = glm::vec3(
-                    Random::Float(allowedXRegion.x, allowedXRegion.y),
-                    Random::Float(allowedYRegion.x, allowedYRegion.y), 0.0f);
+                enemyPosition = glm::vec2(Random::Float(allowedXRegion.x, allowedXRegion.y),
+                                          Random::Float(allowedYRegion.x, allowedYRegion.y));
             }
-
-            m_Registry.Get<Component::GemWarsRigidBody2D>(enemy).Velocity = glm::normalize(Random::Float2(-1.0, 1.0));
-            m_Registry.Add<Component::GemWarsMesh2D>(enemy, Random::UInt32(3, 8), nullptr,
-                                                         glm::vec4(Random::Float3(0.2f, 0.6f), 1.0));
-            m_Registry.Add<Component::GemWarsScore>(enemy, 
-                m_Registry.Get<Component::GemWarsMesh2D>(enemy).Shape.GetNumberOfVertices() * 10);
-            m_Registry.Add<Component::GemWarsEnemyTag>(enemy);
+            while (glm::length2(enemyPosition - playerPosition) < minDistance);
+
+            Component::GemWarsRigidBody2D rb(enemyRadius, Random::Float(2.0, 5.0f),
+                                             Random::Float(glm::radians(30.0f), glm::radians(90.0f)));
+            rb.Velocity = glm::normalize(Random::Float2(-1.0, 1.0));
+            Component::GemWarsMesh2D mesh(Random::UInt32(3, 8), nullptr, glm::vec4(Random::Float3(0.2f, 0.6f), 1.0));
+            U32 score = mesh.Shape.GetNumberOfVertices() * 10;
+
+            DeferredEntity enemy = commandBuffer.CreateEntity("enemy");
+            commandBuffer.Add<Component::GemWarsTransform2D>(enemy, enemyPosition, glm::vec2{enemyRadius}, 0.0f);
+            commandBuffer.Add<Component::GemWarsRigidBody2D>(enemy, rb);
+            commandBuffer.Add<Component::GemWarsMesh2D>(enemy, std::move(mesh));
+            commandBuffer.Add<Component::GemWarsScore>(enemy, score);
+            commandBuffer.Add<Component::GemWarsEnemyTag>(enemy);
         }
 
         m_LastEnemySpawnTime = m_CurrentFrame;
@@ -139,30 +167,31 @@ void GemWarsExample::SpawnParticles(Entity entity)
     F32 particleSpeed = 2.0f;
     I32 particlesLifetime = 60;
 
-    auto& transform2D = m_Registry.Get<Component::GemWarsTransform2D>(entity);
+    Component::GemWarsTransform2D transform2D = m_Registry.Get<Component::GemWarsTransform2D>(entity);
+    F32 collisionRadius = m_Registry.Get<Component::GemWarsRigidBody2D>(entity).CollisionRadius;
+    glm::vec2 particlesSize = transform2D.Scale / 2.0f;
+    Component::GemWarsMesh2D mesh(numberOfParticles, nullptr, glm::vec4{1.0f});
+    mesh.Tint = m_Registry.Get<Component::GemWarsMesh2D>(entity).Tint;
+
+    std::vector<Entity> particles = m_Registry.CreateEntities(numberOfParticles, "particle",
+        Component::GemWarsTransform2D(transform2D.Position, particlesSize, 0.0f),
+        Component::GemWarsRigidBody2D(particlesSize.x, particleSpeed),
+        mesh,
+        Component::GemWarsLifeSpan(particlesLifetime),
+        Component::GemWarsParticleTag{});
     for (U32 i = 0; i < numberOfParticles; i++)
     {
-        glm::vec2 particlesSize = transform2D.Scale / 2.0f;
         F32 phase = 2.0f * glm::pi<float>() * F32(i) / F32(numberOfParticles);
         F32 rotation = transform2D.Rotation;
-        glm::vec3 particlePos = glm::vec3(glm::vec2(glm::sin(phase), glm::cos(phase)), 0.0f) * m_Registry.Get<Component::GemWarsRigidBody2D>(entity).CollisionRadius;
+        glm::vec3 particlePos = glm::vec3(glm::vec2(glm::sin(phase), glm::cos(phase)), 0.0f) * collisionRadius;
         particlePos = {
             glm::cos(rotation) * particlePos.x - glm::sin(rotation) * particlePos.y,
             glm::sin(rotation) * particlePos.x + glm::cos(rotation) * particlePos.y,
             0.0f
         };
         particlePos += transform2D.Position;
-        glm::vec2 particleVelocity = glm::normalize(particlePos - transform2D.Position);
-
-        Entity particle = m_Registry.CreateEntity("particle");
-        m_Registry.Add<Component::GemWarsTransform2D>(particle, particlePos, particlesSize, 0.0f);
-        auto& rb = m_Registry.Add<Component::GemWarsRigidBody2D>(particle, particlesSize.x, particleSpeed);
-        rb.Velocity = particleVelocity;
-        auto& gwm = m_Registry.Add<Component::GemWarsMesh2D>(particle, numberOfParticles, nullptr,
-                                                        glm::vec4{1.0f});
-        gwm.Tint = m_Registry.Get<Component::GemWarsMesh2D>(entity).Tint;
-        m_Registry.Add<Component::GemWarsLifeSpan>(particle, particlesLifetime);
-        m_Registry.Add<Component::GemWarsParticleTag>(particle);
+        m_Registry.Get<Component::GemWarsTransform2D>(particles[i]).Field<TRANSFORM_POSITION>() = particlePos;
+        m_Registry.Get<Component::GemWarsRigidBody2D>(particles[i]).Velocity = glm::normalize(particlePos - transform2D.Position);
     }
 }
 
@@ -170,17 +199,20 @@ void GemWarsExample::SpawnBullet(Entity entity, const glm::vec2& target)
 {
     F32 bulletSpeed = 15.0f;
     F32 bulletRadius = 0.02f;
-    glm::vec2 bulletVelocity = target - glm::vec2(m_Registry.Get<Component::GemWarsTransform2D>(entity).Position);
+    glm::vec2 bulletVelocity = target - glm::vec2(m_Registry.Get<Component::GemWarsTransform2D>(entity).Field<TRANSFORM_POSITION>());
     bulletVelocity += Random::Float2(-0.3f, 0.3f);
     bulletVelocity = glm::normalize(bulletVelocity);
-    glm::vec2 bulletPosition = glm::vec2(m_Registry.Get<Component::GemWarsTransform2D>(entity).Position) +
+    glm::vec2 bulletPosition = glm::vec2(m_Registry.Get<Component::GemWarsTransform2D>(entity).Field<TRANSFORM_POSITION>()) +
         m_Registry.Get<Component::GemWarsRigidBody2D>(entity).CollisionRadius * bulletVelocity;
-    Entity bullet = m_Registry.CreateEntity("bullet");
-    m_Registry.Add<Component::GemWarsTransform2D>(bullet, bulletPosition, glm::vec2{bulletRadius}, 0.0f);
-    auto& rb = m_Registry.Add<Component::GemWarsRigidBody2D>(bullet, bulletRadius, bulletSpeed);
+    Component::GemWarsRigidBody2D rb(bulletRadius, bulletSpeed);
     rb.Velocity = bulletVelocity;
-    m_Registry.Add<Component::GemWarsMesh2D>(bullet, 4, nullptr, glm::vec4(0.6f, 0.9f, 0.2f, 1.0f));
-    m_Registry.Add<Component::GemWarsBulletTag>(bullet);
+
+    EntityCommandBuffer& commandBuffer = m_Systems.GetCommandBuffer();
+    DeferredEntity bullet = commandBuffer.CreateEntity("bullet");
+    commandBuffer.Add<Component::GemWarsTransform2D>(bullet, bulletPosition, glm::vec2{bulletRadius}, 0.0f);
+    commandBuffer.Add<Component::GemWarsRigidBody2D>(bullet, rb);
+    commandBuffer.Add<Component::GemWarsMesh2D>(bullet, 4, nullptr, glm::vec4(0.6f, 0.9f, 0.2f, 1.0f));
+    commandBuffer.Add<Component::GemWarsBulletTag>(bullet);
 }
 
 void GemWarsExample::sSpecialAbility()
@@ -197,7 +229,7 @@ void GemWarsExample::sSpecialAbility()
                     glm::sin(phase) * m_Registry.Get<Component::GemWarsRigidBody2D>(m_Player).CollisionRadius,
                     glm::cos(phase) * m_Registry.Get<Component::GemWarsRigidBody2D>(m_Player).CollisionRadius
                 };
-                position += glm::vec2(m_Registry.Get<Component::GemWarsTransform2D>(m_Player).Position);
+                position += glm::vec2(m_Registry.Get<Component::GemWarsTransform2D>(m_Player).Field<TRANSFORM_POSITION>());
                 SpawnBullet(m_Player, position);
             }
             m_Registry.Get<Component::GemWarsSpecialAbility>(m_Player).RemainingCoolDown = m_Registry.Get<Component::GemWarsSpecialAbility>(m_Player).CoolDown;
@@ -223,15 +255,14 @@ void GemWarsExample::sMovement(F32 dt)
     if (velocity != glm::vec2(0.0f)) velocity = glm::normalize(velocity);
     m_Registry.Get<Component::GemWarsRigidBody2D>(m_Player).Velocity = velocity;
 
-    if (m_Registry.Get<Component::GemWarsInput>(m_Player).Shoot) SpawnBullet(
-        m_Player, m_CameraController->GetCamera()->ScreenToWorldPoint(Input::MousePosition()));
+    if (m_Registry.Get<Component::GemWarsInput>(m_Player).Shoot) SpawnBullet(m_Player, m_ShootTarget);
     // Update all.
-    for (auto entity : View<>(m_Registry))
-    {
-        m_Registry.Get<Component::GemWarsTransform2D>(entity).Position += glm::vec3(
-            m_Registry.Get<Component::GemWarsRigidBody2D>(entity).Velocity * m_Registry.Get<Component::GemWarsRigidBody2D>(entity).Speed * dt, 0.0f);
-        m_Registry.Get<Component::GemWarsTransform2D>(entity).Rotation += m_Registry.Get<Component::GemWarsRigidBody2D>(entity).RotationSpeed * dt;
-    }
+    View<Component::GemWarsTransform2D, Component::GemWarsRigidBody2D>(m_Registry).ParallelEach(
+        [dt](auto tf, auto& rb)
+        {
+            tf.template Field<TRANSFORM_POSITION>() += glm::vec3(rb.Velocity * rb.Speed * dt, 0.0f);
+            tf.template Field<TRANSFORM_ROTATION>() += rb.RotationSpeed * dt;
+        });
 }
 
 void GemWarsExample::sCollision()
@@ -260,7 +291,7 @@ void GemWarsExample::sCollision()
 
     // Check for player-walls collision.
     F32 playerRadius = m_Registry.Get<Component::GemWarsRigidBody2D>(m_Player).CollisionRadius;
-    glm::vec3& playerPosition = m_Registry.Get<Component::GemWarsTransform2D>(m_Player).Position;
+    glm::vec3& playerPosition = m_Registry.Get<Component::GemWarsTransform2D>(m_Player).Field<TRANSFORM_POSITION>();
     if (playerPosition.x + playerRadius > m_Bounds.TopRight.x) playerPosition.x = m_Bounds.TopRight.x - playerRadius;
     if (playerPosition.y + playerRadius > m_Bounds.TopRight.y) playerPosition.y = m_Bounds.TopRight.y - playerRadius;
     if (playerPosition.x - playerRadius < m_Bounds.BottomLeft.x) playerPosition.x = m_Bounds.BottomLeft.x +
@@ -269,19 +300,21 @@ void GemWarsExample::sCollision()
         playerRadius;
 
     // Check for enemy-walls collision.
-    for (auto entity : View<Component::GemWarsEnemyTag>(m_Registry))
-    {
-        if (m_Registry.Get<Component::GemWarsTransform2D>(entity).Position.x + m_Registry.Get<Component::GemWarsRigidBody2D>(entity).CollisionRadius > m_Bounds.TopRight.x ||
-            m_Registry.Get<Component::GemWarsTransform2D>(entity).Position.x - m_Registry.Get<Component::GemWarsRigidBody2D>(entity).CollisionRadius < m_Bounds.BottomLeft.x)
-        {
-            m_Registry.Get<Component::GemWarsRigidBody2D>(entity).Velocity.x *= -1.0f;
-        }
-        if (m_Registry.Get<Component::GemWarsTransform2D>(entity).Position.y + m_Registry.Get<Component::GemWarsRigidBody2D>(entity).CollisionRadius > m_Bounds.TopRight.y ||
-            m_Registry.Get<Component::GemWarsTransform2D>(entity).Position.y - m_Registry.Get<Component::GemWarsRigidBody2D>(entity).CollisionRadius < m_Bounds.BottomLeft.y)
+    View<Component::GemWarsEnemyTag, Component::GemWarsTransform2D, Component::GemWarsRigidBody2D>(m_Registry).Each(
+        [this](auto&, auto tf, auto& rb)
         {
-            m_Registry.Get<Component::GemWarsRigidBody2D>(entity).Velocity.y *= -1.0f;
-        }
-    }
+            const glm::vec3& position = tf.template Field<TRANSFORM_POSITION>();
+            if (position.x + rb.CollisionRadius > m_Bounds.TopRight.x ||
+                position.x - rb.CollisionRadius < m_Bounds.BottomLeft.x)
+            {
+                rb.Velocity.x *= -1.0f;
+            }
+            if (position.y + rb.CollisionRadius > m_Bounds.TopRight.y ||
+                position.y - rb.CollisionRadius < m_Bounds.BottomLeft.y)
+            {
+                rb.Velocity.y *= -1.0f;
+            }
+        });
 
     // Check bullet-enemy collision.
     for (auto bullet : View<Component::GemWarsBulletTag>(m_Registry))
@@ -299,20 +332,20 @@ void GemWarsExample::sCollision()
         }
     }
     // Check bullet-wall collision.
-    for (auto bullet : View<Component::GemWarsBulletTag>(m_Registry))
-    {
-        if (m_Registry.Get<Component::GemWarsTransform2D>(bullet).Position.x - m_Registry.Get<Component::GemWarsRigidBody2D>(bullet).CollisionRadius > m_Bounds.TopRight.x ||
-            m_Registry.Get<Component::GemWarsTransform2D>(bullet).Position.x + m_Registry.Get<Component::GemWarsRigidBody2D>(bullet).CollisionRadius < m_Bounds.BottomLeft.x)
-        {
-            m_Registry.DeleteEntity(bullet);
-            continue;
-        }
-        if (m_Registry.Get<Component::GemWarsTransform2D>(bullet).Position.y - m_Registry.Get<Component::GemWarsRigidBody2D>(bullet).CollisionRadius > m_Bounds.TopRight.y ||
-            m_Registry.Get<Component::GemWarsTransform2D>(bullet).Position.y + m_Registry.Get<Component::GemWarsRigidBody2D>(bullet).CollisionRadius < m_Bounds.BottomLeft.y)
+    EntityCommandBuffer commandBuffer(m_Registry);
+    View<Component::GemWarsBulletTag, Component::GemWarsTransform2D, Component::GemWarsRigidBody2D>(m_Registry).Each(
+        [this, &commandBuffer](Entity bullet, auto&, auto tf, auto& rb)
         {
-            m_Registry.DeleteEntity(bullet);
-        }
-    }
+            const glm::vec3& position = tf.template Field<TRANSFORM_POSITION>();
+            if (position.x - rb.CollisionRadius > m_Bounds.TopRight.x ||
+                position.x + rb.CollisionRadius < m_Bounds.BottomLeft.x ||
+                position.y - rb.CollisionRadius > m_Bounds.TopRight.y ||
+                position.y + rb.CollisionRadius < m_Bounds.BottomLeft.y)
+            {
+                commandBuffer.DeleteEntity(bullet);
+            }
+        });
+    commandBuffer.Playback();
 }
 
 void GemWarsExample::sUserInput()
@@ -323,6 +356,8 @@ void GemWarsExample::sUserInput()
     m_Registry.Get<Component::GemWarsInput>(m_Player).Down = Input::GetKey(Key::S);
     m_Registry.Get<Component::GemWarsInput>(m_Player).Shoot = Input::GetMouseButton(Mouse::Button0) || Input::GetKeyDown(Key::E);
     m_Registry.Get<Component::GemWarsInput>(m_Player).SpecialAbility = Input::GetMouseButton(Mouse::Button1);
+    // Systems may run on worker threads, so input is sampled here.
+    m_ShootTarget = m_CameraController->GetCamera()->ScreenToWorldPoint(Input::MousePosition());
 
     if (Input::GetKeyDown(Key::Space))
     {
@@ -348,7 +383,7 @@ void GemWarsExample::sRender()
 
     for (const auto e: View<Component::GemWarsTransform2D, Component::GemWarsMesh2D>(m_Registry))
     {
-        auto& cTf = m_Registry.Get<Component::GemWarsTransform2D>(e);
+        Component::GemWarsTransform2D cTf = m_Registry.Get<Component::GemWarsTransform2D>(e);
         transform.Position = cTf.Position;
         transform.Scale = cTf.Scale;
         transform.Rotation = cTf.Rotation;
@@ -385,21 +420,20 @@ void GemWarsExample::sRender()
 
 void GemWarsExample::sParticleUpdate()
 {
-    for (auto particle : View<Component::GemWarsParticleTag>(m_Registry))
-    {
-        I32 lifeSpan = m_Registry.Get<Component::GemWarsLifeSpan>(particle).Remaining;
-        if (lifeSpan <= 0)
-        {
-            m_Registry.DeleteEntity(particle);
-        }
-        else
+    EntityCommandBuffer& commandBuffer = m_Systems.GetCommandBuffer();
+    View<Component::GemWarsParticleTag, Component::GemWarsLifeSpan, Component::GemWarsMesh2D>(m_Registry).Each(
+        [&commandBuffer](Entity particle, auto&, auto& lifeSpan, auto& mesh)
         {
-            I32 lifeSpanTotal = m_Registry.Get<Component::GemWarsLifeSpan>(particle).Total;
-            F32 alpha = F32(lifeSpan) / F32(lifeSpanTotal);
-            m_Registry.Get<Component::GemWarsMesh2D>(particle).Tint.a = alpha;
-            m_Registry.Get<Component::GemWarsLifeSpan>(particle).Remaining--;
-        }
-    }
+            if (lifeSpan.Remaining <= 0)
+            {
+                commandBuffer.DeleteEntity(particle);
+            }
+            else
+            {
+                mesh.Tint.a = F32(lifeSpan.Remaining) / F32(lifeSpan.Total);
+                lifeSpan.Remaining--;
+            }
+        });
 }
 
 void GemWarsExample::SetBounds()
@@ -414,10 +448,10 @@ bool GemWarsExample::Collide(Entity a, Entity b)
 {
     auto& rbA = m_Registry.Get<Component::GemWarsRigidBody2D>(a);
     auto& rbB = m_Registry.Get<Component::GemWarsRigidBody2D>(b);
-    auto& tfA = m_Registry.Get<Component::GemWarsTransform2D>(a);
-    auto& tfB = m_Registry.Get<Component::GemWarsTransform2D>(b);
+    glm::vec2 positionA = glm::vec2(m_Registry.Get<Component::GemWarsTransform2D>(a).Field<TRANSFORM_POSITION>());
+    glm::vec2 positionB = glm::vec2(m_Registry.Get<Component::GemWarsTransform2D>(b).Field<TRANSFORM_POSITION>());
     F32 minDistance = (rbA.CollisionRadius + rbB.CollisionRadius) * (rbA.CollisionRadius + rbB.CollisionRadius);
-    return (glm::length2(glm::vec2(tfA.Position) - glm::vec2(tfB.Position)) < minDistance);
+    return (glm::length2(positionA - positionB) < minDistance);
 }
 
 void GemWarsExample::OnEvent(Event& event)
@@ -29,6 +29,7 @@ private:
 	void SpawnPlayer();
 	void SpawnParticles(Entity entity);
 	void SpawnBullet(Entity entity, const glm::vec2& target);
+	void InitSystems();
 
 	void sEnemySpawner();
 	void sMovement(F32 dt);
@@ -48,12 +49,14 @@ private:
 	Ref<CameraController> m_CameraController;
 
 	Registry m_Registry;
+	SystemGraph m_Systems{m_Registry};
 	
 	U64 m_CurrentFrame = 0;
 	U64 m_LastEnemySpawnTime = 0;
 	U64 m_IsRunning = true;
 
 	Entity m_Player;
+	glm::vec2 m_ShootTarget = glm::vec2{ 0.0f };
 
 	AABB m_Bounds = {};
 
@@ -187,8 +187,11 @@ Ref<FSMState> DefaultCoinState::OnUpdate(F32 dt)
     auto&& [registry, config] = m_FSM.As<BlockFSM>().GetRegistryConfigPair();
     if (m_WasPickedUp)
     {
-        MarioSceneUtils::SpawnScoreEntity(m_FSM.GetScene(), config.SpawnedCoinScore, m_Entity);
-        SceneUtils::DeleteEntity(m_FSM.GetScene(), m_Entity);
+        // Coin is deleted by kill system (it handles hierarchy and prefabs).
+        auto& commandBuffer = static_cast<MarioScene&>(m_FSM.GetScene()).GetCommandBuffer();
+        MarioSceneUtils::SpawnScoreEntity(commandBuffer, registry, config.SpawnedCoinScore, m_Entity);
+        commandBuffer.Add<Component::LifeTimeComponent>(m_Entity, Component::LifeTimeComponent{0.0, 0.0});
+        m_WasPickedUp = false;
     }
     return nullptr;
 }
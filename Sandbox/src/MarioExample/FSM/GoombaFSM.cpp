@@ -155,9 +155,9 @@ Ref<FSMState> GoombaDeathState::OnUpdate(F32 dt)
 {
     // Basically physics engine really doesn't like when we delete colliders / rb during physics step.
     if (m_WasDeleted) return nullptr;
-    auto& registry = m_FSM.GetScene().GetRegistry();
-    registry.Remove<Component::BoxCollider2D>(m_Entity);
-    registry.Remove<Component::RigidBody2D>(m_Entity);
+    auto& commandBuffer = static_cast<MarioScene&>(m_FSM.GetScene()).GetCommandBuffer();
+    commandBuffer.Remove<Component::BoxCollider2D>(m_Entity);
+    commandBuffer.Remove<Component::RigidBody2D>(m_Entity);
     m_WasDeleted = true;
     return nullptr;
 }
\ No newline at end of file
@@ -15,6 +15,11 @@ MarioScene::MarioScene()
 
 void MarioScene::OnInit()
 {
+    // Transforms are propagated and subtrees are deleted with linear walks over `ParentRel` pool.
+    m_SceneGraph.SetFlattenedHierarchy(true);
+    InitSystems();
+    InitPhysicsObservers();
+
     m_PlayerFsm.ReadConfig("assets/configs/PlayerFSM.yaml");
     m_GoombaFsm.ReadConfig("assets/configs/GoombaFSM.yaml");
     m_PiranhaPlantFsm.ReadConfig("assets/configs/PiranhaPlantFSM.yaml");
@@ -73,18 +78,12 @@ void MarioScene::OnUpdate(F32 dt)
 {
     if (!m_IsSceneReady) return;
 
+    // Entities of loaded scene, prefabs and editor additions get their physics state before systems use it.
+    SynchronizeAddedPhysics();
     if (m_IsPlaying)
     {
         // Call systems.
-        m_PlayerFsm.OnUpdate(dt);
-        m_GoombaFsm.OnUpdate(dt);
-        m_PiranhaPlantFsm.OnUpdate(dt);
-        m_KoopaFsm.OnUpdate(dt);
-        m_BlockFsm.OnUpdate(dt);
-        SKill(dt);
-        SPhysics(dt);
-        SAnimation(dt);
-        SGameState();
+        m_Systems.Run(dt);
     }
     
     auto* camera = GetMainCamera();
@@ -143,17 +142,19 @@ void MarioScene::OnImguiUpdate()
     if (!m_IsSceneReady) return;
     
     m_ScenePanels.OnImguiUpdate();
+
+    ImGui::Begin("Systems");
+    for (auto& timing : m_Systems.GetTimings())
+    {
+        ImGui::Text("%-16s %.3f ms (avg %.3f ms)", timing.Name.data(), timing.LastTimeMs, timing.AverageTimeMs);
+    }
+    ImGui::End();
 }
 
 void MarioScene::OnSceneGlobalUpdate(Entity addedEntity)
 {
     InitEntities();
     m_SceneGraph.UpdateGraphOfEntity(addedEntity);
-    SceneUtils::TraverseTree(addedEntity, m_Registry, [&](Entity e)
-    {
-        if (m_Registry.Has<Component::BoxCollider2D>(e)) SceneUtils::SynchronizePhysics(*this, e, SceneUtils::PhysicsSynchroSetting::ColliderOnly);
-        if (m_Registry.Has<Component::RigidBody2D>(e)) SceneUtils::SynchronizePhysics(*this, e, SceneUtils::PhysicsSynchroSetting::RBOnly);
-    });
     m_ScenePanels.ResetActiveEntity();
 }
 
@@ -167,8 +168,9 @@ void MarioScene::Open(const std::string& filename)
     m_SceneSerializer.Deserialize("assets/scenes/" + path + ".scene");
     
     InitEntities();
+    // Deserialized `ParentRel` count may match the one of previous scene.
+    m_SceneGraph.RebuildHierarchyOrder();
     m_SceneGraph.OnUpdate();
-    SceneUtils::SynchronizePhysics(*this);
     m_ScenePanels.ResetActiveEntity();
     SceneUtils::SynchronizeCamerasWithTransforms(*this);
     m_IsSceneReady = true;
@@ -188,6 +190,7 @@ void MarioScene::Clear()
     Renderer2D::Reset();
     m_Registry.Clear();
     m_RigidBodyWorld2D.Clear();
+    m_AddedPhysicsEntities.clear();
     m_Player = NULL_ENTITY;
 }
 
@@ -284,11 +287,14 @@ void MarioScene::SKill(F32 dt)
 
 void MarioScene::SPhysics(F32 dt)
 {
+    // Entities spawned by systems of this frame.
+    SynchronizeAddedPhysics();
     SceneUtils::PreparePhysics(*this);
     m_RigidBodyWorld2D.Update(dt);
+    // Bodies write straight into (pointer-stable) world transforms, only change ticks are left to update.
     for (auto e : View<Component::RigidBody2D>(m_Registry))
     {
-        SceneUtils::SynchronizeWithPhysics(*this, e);
+        m_Registry.MarkChanged<Component::LocalToWorldTransform2D>(e);
     }
     for (auto e : View<Component::RigidBody2D, Component::LocalToParentTransform2D>(m_Registry))
     {
@@ -306,12 +312,27 @@ void MarioScene::SRender()
     camera->CameraFrameBuffer->ClearAttachment(1, RendererAPI::DataType::Int, &clearInteger);
     Renderer2D::BeginScene(camera->CameraController->GetCamera().get());
 
-    for (auto e : View<Component::SpriteRenderer>(m_Registry))
+    // Keep sprites grouped by layer and texture, so that batches are not split by texture changes.
+    // Sort keys change only when sprites are added or marked changed (see `SAnimation`), so most frames skip it.
+    if (m_Registry.IsComponentExists(ComponentFamily::TYPE<Component::SpriteRenderer>))
     {
-        auto& tf = m_Registry.Get<Component::LocalToWorldTransform2D>(e);
-        auto& sr = m_Registry.Get<Component::SpriteRenderer>(e);
-        Renderer2D::DrawQuadEditor(e.Id, tf, sr);
+        const auto& sprites = m_Registry.GetComponentPool<Component::SpriteRenderer>();
+        if (sprites.GetLayoutVersion() != m_SpritesSortedVersion || sprites.GetChangeTick() > m_SpritesSortedTick)
+        {
+            m_Registry.Sort<Component::SpriteRenderer>([](const auto& a, const auto& b)
+            {
+                return std::tie(a.SortingLayer.Priority, a.OrderInLayer, a.Texture) <
+                    std::tie(b.SortingLayer.Priority, b.OrderInLayer, b.Texture);
+            });
+            m_SpritesSortedVersion = sprites.GetLayoutVersion();
+            m_SpritesSortedTick = m_Registry.AdvanceChangeTick();
+        }
     }
+    View<Component::SpriteRenderer, Component::LocalToWorldTransform2D>(m_Registry).Each(
+        [](Entity e, auto& sr, auto& tf)
+        {
+            Renderer2D::DrawQuadEditor(e.Id, tf, sr);
+        });
 
     SRenderText();
     SGameMenu();
@@ -389,12 +410,17 @@ void MarioScene::SAnimation(F32 dt)
         animation.SpriteAnimation->Update(dt);
         if (animation.SpriteAnimation->HasEnded())
         {
-            m_Registry.Remove<Component::Animation>(e);
+            m_Systems.GetCommandBuffer().Remove<Component::Animation>(e);
         }
         // Update entity's sprite.
         auto& sr = m_Registry.Get<Component::SpriteRenderer>(e);
         sr.UV = animation.SpriteAnimation->GetCurrentFrameUV();
-        sr.Texture = animation.SpriteAnimation->GetSpriteSheet();
+        // Texture is a sort key of `SRender`.
+        if (sr.Texture != animation.SpriteAnimation->GetSpriteSheet())
+        {
+            sr.Texture = animation.SpriteAnimation->GetSpriteSheet();
+            m_Registry.MarkChanged<Component::SpriteRenderer>(e);
+        }
     }
 }
 
@@ -544,6 +570,56 @@ void MarioScene::InitGameWinCollisionCallback()
     }
 }
 
+void MarioScene::InitSystems()
+{
+    // FSMs record structural changes into command buffer of the graph (collision responses
+    // run inside of physics step).
+    // Player polls input (GLFW is main thread only).
+    m_Systems.AddSystem("PlayerFSM", [this](F32 dt) { m_PlayerFsm.OnUpdate(dt); }).Exclusive();
+    m_Systems.AddSystem("GoombaFSM", [this](F32 dt) { m_GoombaFsm.OnUpdate(dt); })
+        .Reads<MarioGoombaTag>()
+        .Writes<Component::FSMStateComp, Component::RigidBody2D, Component::SpriteRenderer>();
+    m_Systems.AddSystem("PiranhaPlantFSM", [this](F32 dt) { m_PiranhaPlantFsm.OnUpdate(dt); })
+        .Reads<MarioPiranhaPlantTag>()
+        .Writes<Component::FSMStateComp, Component::LocalToParentTransform2D>();
+    m_Systems.AddSystem("KoopaFSM", [this](F32 dt) { m_KoopaFsm.OnUpdate(dt); })
+        .Reads<MarioKoopaTag>()
+        .Writes<Component::FSMStateComp, Component::RigidBody2D, Component::SpriteRenderer>();
+    m_Systems.AddSystem("BlockFSM", [this](F32 dt) { m_BlockFsm.OnUpdate(dt); })
+        .Reads<MarioLevelTag, Component::LocalToWorldTransform2D>()
+        .Writes<Component::FSMStateComp, Component::LocalToParentTransform2D, Component::Animation>();
+    // Deletes through `SceneUtils` (hierarchy, prefabs and scene panels).
+    m_Systems.AddSystem("Kill", [this](F32 dt) { SKill(dt); }).Exclusive();
+    // Steps physics world.
+    m_Systems.AddSystem("Physics", [this](F32 dt) { SPhysics(dt); }).Exclusive();
+    m_Systems.AddSystem("Animation", [this](F32 dt) { SAnimation(dt); })
+        .Writes<Component::Animation, Component::SpriteRenderer>();
+    // Reads input and may open another scene.
+    m_Systems.AddSystem("GameState", [this](F32) { SGameState(); }).Exclusive();
+}
+
+void MarioScene::InitPhysicsObservers()
+{
+    // Physics state is written once the entity is fully set up (at the start of the frame and before physics step).
+    auto onAdded = [this](Entity e) { m_AddedPhysicsEntities.push_back(e); };
+    m_Registry.OnConstruct<Component::RigidBody2D>().Connect(onAdded);
+    m_Registry.OnConstruct<Component::BoxCollider2D>().Connect(onAdded);
+}
+
+void MarioScene::SynchronizeAddedPhysics()
+{
+    // Entity with both components is added twice.
+    std::ranges::sort(m_AddedPhysicsEntities, {}, &Entity::Id);
+    m_AddedPhysicsEntities.erase(std::unique(m_AddedPhysicsEntities.begin(), m_AddedPhysicsEntities.end()), m_AddedPhysicsEntities.end());
+    for (auto e : m_AddedPhysicsEntities)
+    {
+        if (!m_Registry.IsEntityExists(e)) continue;
+        if (m_Registry.Has<Component::BoxCollider2D>(e)) SceneUtils::SynchronizePhysics(*this, e, SceneUtils::PhysicsSynchroSetting::ColliderOnly);
+        if (m_Registry.Has<Component::RigidBody2D>(e)) SceneUtils::SynchronizePhysics(*this, e, SceneUtils::PhysicsSynchroSetting::RBOnly);
+    }
+    m_AddedPhysicsEntities.clear();
+}
+
 void MarioScene::RenderEditor()
 {
     auto* camera = GetMainCamera();
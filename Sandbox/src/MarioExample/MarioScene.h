@@ -40,6 +40,7 @@ public:
     FrameBuffer* GetMainFrameBuffer() override;
 
     void AddSensorCallback(const std::string& callbackName, CollisionCallback::SensorCallback callback);
+    EntityCommandBuffer& GetCommandBuffer() { return m_Systems.GetCommandBuffer(); }
     
     void PerformAction(Action& action) override {}
 public:
@@ -62,6 +63,9 @@ private:
     void InitBlock();
     void InitCameraController();
     void InitGameWinCollisionCallback();
+    void InitSystems();
+    void InitPhysicsObservers();
+    void SynchronizeAddedPhysics();
 
     void RenderEditor();
     void ValidateViewport();
@@ -86,6 +90,14 @@ private:
     KoopaFSM m_KoopaFsm;
     BlockFSM m_BlockFsm;
 
+    SystemGraph m_Systems{m_Registry};
+    // Entities, that got rigid body or collider since the last `SynchronizeAddedPhysics` (drained every frame).
+    std::vector<Entity> m_AddedPhysicsEntities;
+
+    // Layout version and change tick of sprite pool, when `SRender` has sorted it last time.
+    U32 m_SpritesSortedVersion{0};
+    U32 m_SpritesSortedTick{0};
+
     Entity m_Player{NULL_ENTITY};
     GameState m_GameState{GameState::Menu};
     std::string m_DefaultScene{"Game menu"};
@@ -4,19 +4,19 @@
 
 namespace MarioSceneUtils
 {
-    inline void SpawnScoreEntity(Scene& scene, U32 score, Entity spawner)
+    // Records score entity into `commandBuffer` (for systems, that shall not make structural changes).
+    inline void SpawnScoreEntity(EntityCommandBuffer& commandBuffer, Registry& registry, U32 score, Entity spawner)
     {
-        auto&& [scoreE, tf] = SceneUtils::AddDefaultEntity(scene, "Score");
-        auto& registry = scene.GetRegistry();
+        Component::LocalToWorldTransform2D tf;
         auto& spawnerTf = registry.Get<Component::LocalToWorldTransform2D>(spawner);
         tf.Position = spawnerTf.Position; tf.Scale = spawnerTf.Scale;
         tf.Position.y += tf.Scale.y;
-        auto& scoreComp = registry.Add<Component::ScoreComponent>(scoreE);
+        Component::ScoreComponent scoreComp;
         scoreComp.Score = score;
-        auto& lifeTime = registry.Add<Component::LifeTimeComponent>(scoreE);
+        Component::LifeTimeComponent lifeTime;
         lifeTime.LifeTime = lifeTime.LifeTimeLeft = 1.5;
 
-        auto& fr = registry.Add<Component::FontRenderer>(scoreE);
+        Component::FontRenderer fr;
         fr.Tint = {0.9f, 0.9f, 1.0f, 1.0f};
         fr.FontSize = 36.0f;
         fr.Zoom = 8;
@@ -24,6 +24,20 @@ namespace MarioSceneUtils
             .Min = {tf.Position.x, tf.Position.y },
             .Max = {std::numeric_limits<F32>::max(), std::numeric_limits<F32>::max()}
         };
+
+        DeferredEntity scoreE = commandBuffer.CreateEntity("Score");
+        commandBuffer.Add<Component::LocalToWorldTransform2D>(scoreE, tf);
+        commandBuffer.Add<Component::ScoreComponent>(scoreE, scoreComp);
+        commandBuffer.Add<Component::LifeTimeComponent>(scoreE, lifeTime);
+        commandBuffer.Add<Component::FontRenderer>(scoreE, fr);
+    }
+
+    inline void SpawnScoreEntity(Scene& scene, U32 score, Entity spawner)
+    {
+        auto& registry = scene.GetRegistry();
+        EntityCommandBuffer commandBuffer(registry);
+        SpawnScoreEntity(commandBuffer, registry, score, spawner);
+        commandBuffer.Playback();
     }
 
     inline Entity SpawnCoin(Scene& scene, U32 score, Entity spawner)
@@ -40,7 +54,6 @@ namespace MarioSceneUtils
         rb.Type = Physics::RigidBodyType2D::Dynamic;
         SceneUtils::AddDefaultPhysicalRigidBody2D(scene, coin);
         rb.PhysicsBody->SetMass(0.2f);
-        SceneUtils::SynchronizePhysics(scene, coin, SceneUtils::PhysicsSynchroSetting::RBOnly);
         SpawnScoreEntity(scene, score, spawner);
         return coin;
     }
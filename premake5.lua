@@ -23,4 +23,6 @@ group "Dependencies"
 	
 group""
 	include "Engine"
-	include "Sandbox"
\ No newline at end of file
+	include "Sandbox"
+	include "EngineBench"
+	include "EngineTests"
\ No newline at end of file